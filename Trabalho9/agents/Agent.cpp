@@ -1,50 +1,35 @@
 #include "Agent.h"
-#include "behaviors/BasicAgentBehavior.h"
+#include "StaticBehaviors.h"
+#include <algorithm>
 
-Agent::Agent(Vector2 start, Vector2 target, std::unique_ptr<IAgentBehavior> behavior) 
-    : position(start), 
-      target(target),
-      broadRadius(Agent::DEFAULT_BROAD_RADIUS),
-      collRadius(Agent::DEFAULT_COLLISION_RADIUS),
-      has_path(false), 
-      color(GetRandomColor()), 
-      currentPathIndex(0) {
-    
-    if (!behavior) {
-        this->behavior = std::make_unique<BasicAgentBehavior>();
-    } else {
-        this->behavior = std::move(behavior);
+void Agent::Update(Grid& grid, float delta_time, CommandBuffer& commandBuffer) {
+    uint8_t kind = storage->behaviorKind[index];
+    if (kind == AgentStorage::DYNAMIC_BEHAVIOR) {
+        storage->cold[index].behavior->Update(*this, grid, delta_time, commandBuffer);
+        return;
     }
-    
-    //printf("=== AGENT CREATED ===\n");
-    //printf("Start world: (%.1f, %.1f)\n", start.x, start.y);
-    //printf("Target grid: (%.1f, %.1f)\n", target.x, target.y);
-    //printf("=====================\n");
+    VisitStaticBehavior(kind, [&](auto behavior) {
+        behavior.Update(behavior, *this, BehaviorContext{grid, delta_time, commandBuffer});
+    });
 }
 
-void Agent::Update(Grid& grid, float delta_time, CommandProcessor& commandProcessor) {
-    behavior->Update(*this, grid, target, path, has_path, currentPathIndex, delta_time, commandProcessor);
-}
-
-void Agent::Draw(Grid& grid) {
-    behavior->Draw(grid, position, color);
-}
-
-Color Agent::GetRandomColor() {
-    Color colors[] = {BLUE, PURPLE, ORANGE, PINK, DARKBLUE, DARKPURPLE};
-    return colors[GetRandomValue(0, 5)];
+Color Agent::GetRandomColor(const AgentRandom& random) {
+    Color colors[] = {NavColors::Blue, NavColors::Purple, NavColors::Orange,
+                      NavColors::Pink, NavColors::DarkBlue, NavColors::DarkPurple};
+    return colors[random.Range(0, 0, 5)];
 }
 
 void Agent::AddObserver(IObserver* observer) {
-    observers.push_back(observer);
+    storage->cold[index].observers.push_back(observer);
 }
 
 void Agent::RemoveObserver(IObserver* observer) {
+    auto& observers = storage->cold[index].observers;
     observers.erase(std::remove(observers.begin(), observers.end(), observer), observers.end());
 }
 
 void Agent::Notify() {
-    for (auto observer : observers) {
+    for (auto observer : storage->cold[index].observers) {
         observer->OnNotify(*this);
     }
-}
\ No newline at end of file
+}
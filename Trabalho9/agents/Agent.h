@@ -1,58 +1,92 @@
 #pragma once
-#include "raylib.h"
+#include "NavTypes.h"
 #include "Grid.h"
+#include "AgentStorage.h"
 #include "behaviors/IAgentBehavior.h"
 #include "ISubject.h"
+#include "CommandBuffer.h"
 #include <vector>
 #include <memory>
 
+// Visão leve de um agente guardado em AgentStorage. Copiar um Agent copia só a referência;
+// todos os dados vivem nos arrays do AgentManager. O índice denso só vale até a próxima
+// remoção de agente; para guardar uma referência, use GetHandle().
 class Agent : public ISubject {
 private:
-    Vector2 position;
-    Vector2 target;
-    std::vector<Vector2> path;
-    bool has_path;
-    Color color;
-    int currentPathIndex;
-    float collRadius;
-    float broadRadius;
-    float life = 100.0f;
-    
-    std::unique_ptr<IAgentBehavior> behavior;
-    std::vector<IObserver*> observers;
+    AgentStorage* storage;
+    int index;
     
 public:
     static constexpr float DEFAULT_BROAD_RADIUS = 15.0f;
     static constexpr float DEFAULT_COLLISION_RADIUS = 8.0f;
+    static constexpr float DEFAULT_SPEED = 2.0f;
 
-    Agent(Vector2 start, Vector2 target, std::unique_ptr<IAgentBehavior> behavior = nullptr);
+    Agent(AgentStorage& storage, int index) : storage(&storage), index(index) {}
     
-    void Update(Grid& grid, float delta_time, CommandProcessor& commandProcessor);
-    void Draw(Grid& grid);
-    static Color GetRandomColor();
-    bool HasReachedTarget() const { return !has_path && currentPathIndex >= path.size(); }
+    void Update(Grid& grid, float delta_time, CommandBuffer& commandBuffer);
+    static Color GetRandomColor(const AgentRandom& random);
+    bool HasReachedTarget() const { return GetState() == AgentState::Arrived; }
     
+    // Comportamento virtual (decoradores montados em tempo de execução).
     void SetBehavior(std::unique_ptr<IAgentBehavior> newBehavior) {
-        behavior = std::move(newBehavior);
+        storage->cold[index].behavior = std::move(newBehavior);
+        storage->behaviorKind[index] = AgentStorage::DYNAMIC_BEHAVIOR;
+    }
+    // Comportamento estático: índice de um tipo de StaticBehavior (ver StaticBehaviors.h).
+    void SetStaticBehaviorKind(uint8_t kind) {
+        storage->cold[index].behavior.reset();
+        storage->behaviorKind[index] = kind;
     }
 
-    Vector2 GetPosition() const { return position; }
-    void SetPosition(Vector2 newPosition) { position = newPosition; }
+    int GetIndex() const { return index; }
+    AgentHandle GetHandle() const { return storage->handle[index]; }
+    AgentStorage& GetStorage() const { return *storage; }
+    // Sorteios deste agente no passo atual; podem ser usados dentro de Update.
+    AgentRandom GetRandom() const { return storage->RandomFor(index); }
+
+    Vector2 GetPosition() const { return {storage->positionX[index], storage->positionY[index]}; }
+    void SetPosition(Vector2 newPosition) {
+        storage->positionX[index] = newPosition.x;
+        storage->positionY[index] = newPosition.y;
+    }
+
+    Vector2& Target() { return storage->target[index]; }
+    
+    // Pede para mover o agente até newPosition neste passo. O AgentManager transforma o
+    // pedido num comando MoveAgent depois do Update, passando antes pela evitação local
+    // (OrcaSteering) quando ela está ligada.
+    void RequestMove(Vector2 newPosition) {
+        storage->stepX[index] = newPosition.x - storage->positionX[index];
+        storage->stepY[index] = newPosition.y - storage->positionY[index];
+    }
+    Vector2 GetVelocity() const { return {storage->velocityX[index], storage->velocityY[index]}; }
+    std::vector<Vector2>& Path() { return storage->cold[index].path; }
+    const std::vector<Vector2>& Path() const { return storage->cold[index].path; }
+    int& PathIndex() { return storage->pathIndex[index]; }
+    bool HasPath() const { return GetState() == AgentState::Moving; }
+    AgentState GetState() const { return storage->state[index]; }
+    // Pode ser chamado pelo comportamento durante Update; um agente que passa a dormir só
+    // sai da lista ativa no fim do passo (AgentManager::UpdateAll).
+    void SetState(AgentState newState) { storage->state[index] = newState; }
+    float GetSpeed() const { return storage->speed[index]; }
+    Color GetColor() const { return storage->cold[index].color; }
+    void SetColor(Color color) { storage->cold[index].color = color; }
 
     void AddObserver(IObserver* observer) override;
     void RemoveObserver(IObserver* observer) override;
     void Notify() override;
 
     void TakeDamage(float damage) {
-        life -= damage;
-        if (life <= 0) {
+        storage->life[index] -= damage;
+        storage->Wake(index);
+        if (storage->life[index] <= 0) {
             Notify();
         }
     }
 
-    float getBroadRadius() const { return broadRadius; }
+    float getBroadRadius() const { return storage->broadRadius[index]; }
     
-    float getCollisionRadius() const { return collRadius; }
+    float getCollisionRadius() const { return storage->collRadius[index]; }
 
-    float GetLife() const { return life; }
-};
\ No newline at end of file
+    float GetLife() const { return storage->life[index]; }
+};
@@ -0,0 +1,13 @@
+#pragma once
+#include <cstdint>
+
+// Referência estável a um agente: índice do slot no pool mais a geração do slot. Quando
+// um agente é removido a geração do slot avança, então handles antigos deixam de valer
+// mesmo que o slot seja reaproveitado por outro agente.
+struct AgentHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+    
+    bool operator==(const AgentHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const AgentHandle& other) const { return !(*this == other); }
+};
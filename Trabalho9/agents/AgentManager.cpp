@@ -1,12 +1,18 @@
 #include "AgentManager.h"
-#include "behaviors/BasicAgentBehavior.h"
-#include "raylib.h"
-#include <unordered_map>
+#include "StaticBehaviors.h"
+#include "BehaviorSnapshot.h"
+#include "ThreadPool.h"
+#include "Metrics.h"
+#include <algorithm>
 
 std::unique_ptr<AgentManager> AgentManager::instance = nullptr;
 
-AgentManager::AgentManager(Grid* grid) : grid(grid) {
+AgentManager::AgentManager(Grid* grid) : grid(grid), commandExecutor(agents, *grid) {
     respawnObserver = std::make_unique<AgentRespawnObserver>(*this);
+    collisionDamage = std::make_unique<CollisionDamageSubscriber>(*this);
+    // Edições anteriores ao gerenciador não acordam ninguém: agentes novos já começam ativos.
+    grid->CollectDirtyCells(gridCursor, dirtyCells);
+    dirtyCells.clear();
 }
 
 AgentManager& AgentManager::GetInstance() {
@@ -27,85 +33,338 @@ void AgentManager::DestroyInstance() {
     instance.reset();
 }
 
-void AgentManager::AddAgent(Vector2 start, Vector2 target) {
-    Vector2 worldStart = {start.x * grid->GetCellSize() + grid->GetCellSize() / 2, 
-                         start.y * grid->GetCellSize() + grid->GetCellSize() / 2};
-    agents.emplace_back(worldStart, target);
-    agents.back().AddObserver(respawnObserver.get());
+Agent AgentManager::AddAgent(Vector2 start, Vector2 target) {
+    return AddAgentWithBehavior(start, target, StaticBehavior{});
 }
 
 void AgentManager::AddRandomAgents(int count) {
-    for (int i = 0; i < count; i++) {
-        Vector2 start, target;
-        
-        do {
-            start = {(float)GetRandomValue(0, grid->GetWidth() - 1), 
-                    (float)GetRandomValue(0, grid->GetHeight() - 1)};
-        } while (!grid->IsWalkable((int)start.x, (int)start.y));
+    SpawnAgents(count);
+}
+
+// Sorteia início e alvo no índice de células livres do Grid, sem laços de rejeição. Com
+// sameComponent, o alvo sai da componente conexa do início, então sempre há caminho
+// (a menos da folga exigida pelo raio do agente).
+int AgentManager::SpawnAgents(int count, const StaticBehavior& behavior, bool sameComponent) {
+    agents.Reserve(agents.Size() + count);
+    
+    int spawned = 0;
+    for (; spawned < count; spawned++) {
+        int startX, startY;
+        if (!grid->RandomFreeCell(startX, startY)) break;
         
-        do {
-            target = {(float)GetRandomValue(0, grid->GetWidth() - 1), 
-                     (float)GetRandomValue(0, grid->GetHeight() - 1)};
-        } while (!grid->IsWalkable((int)target.x, (int)target.y) || 
-                (start.x == target.x && start.y == target.y));
+        int targetX = startX, targetY = startY;
+        int component = sameComponent ? grid->GetComponent(startX, startY) : -1;
+        bool canMove = sameComponent ? grid->GetComponentSize(component) > 1 : grid->GetFreeCellCount() > 1;
+        // Com mais de uma célula disponível, cada sorteio repete o início com chance <= 1/2.
+        for (int attempt = 0; canMove && attempt < SPAWN_TARGET_ATTEMPTS; attempt++) {
+            if (sameComponent) {
+                grid->RandomFreeCellInComponent(component, targetX, targetY);
+            } else {
+                grid->RandomFreeCell(targetX, targetY);
+            }
+            if (targetX != startX || targetY != startY) break;
+        }
         
-        AddAgent(start, target);
+        AddAgentWithBehavior({(float)startX, (float)startY}, {(float)targetX, (float)targetY}, behavior);
     }
+    return spawned;
 }
 
-void AgentManager::AddAgentWithBehavior(Vector2 start, Vector2 target, std::unique_ptr<IAgentBehavior> behavior) {
+Agent AgentManager::AddAgentWithBehavior(Vector2 start, Vector2 target, std::unique_ptr<IAgentBehavior> behavior) {
+    if (!behavior) {
+        return AddAgentWithBehavior(start, target, StaticBehavior{});
+    }
+    return AddAgentWithKind(start, target, AgentStorage::DYNAMIC_BEHAVIOR, std::move(behavior));
+}
+
+Agent AgentManager::AddAgentWithBehavior(Vector2 start, Vector2 target, const StaticBehavior& behavior) {
+    return AddAgentWithKind(start, target, (uint8_t)behavior.index(), nullptr);
+}
+
+Agent AgentManager::AddAgentWithKind(Vector2 start, Vector2 target, uint8_t kind, std::unique_ptr<IAgentBehavior> behavior) {
     Vector2 worldStart = {start.x * grid->GetCellSize() + grid->GetCellSize() / 2, 
                          start.y * grid->GetCellSize() + grid->GetCellSize() / 2};
-    agents.emplace_back(worldStart, target, std::move(behavior));
-    agents.back().AddObserver(respawnObserver.get());
+    int index = agents.Add(worldStart, target, Agent::DEFAULT_SPEED, Agent::DEFAULT_COLLISION_RADIUS,
+                           Agent::DEFAULT_BROAD_RADIUS, NavColors::Blue, kind, std::move(behavior));
+    Agent agent(agents, index);
+    agent.SetColor(Agent::GetRandomColor(agent.GetRandom()));
+    agent.AddObserver(respawnObserver.get());
+    commandProcessor.LogEdit(agents.tick);
+    return agent;
 }
 
-void AgentManager::UpdateAll(float delta_time) {
-    for (auto& agent : agents) {
-        agent.Update(*grid, delta_time, commandProcessor);
-    }
-    commandProcessor.ProcessCommands();
+// Remove o agente trocando-o com o último do array denso; o slot volta para a free list
+// com a geração avançada, invalidando handles antigos. Não pode ser chamada durante
+// UpdateAll nem CheckCollision.
+bool AgentManager::RemoveAgent(AgentHandle handle) {
+    if (!agents.Remove(handle)) return false;
+    commandProcessor.LogEdit(agents.tick);
+    return true;
 }
 
-void AgentManager::DrawAll(Grid& grid) {
-    for (auto& agent : agents) {
-        agent.Draw(grid);
-    }
+bool AgentManager::SetTarget(AgentHandle handle, Vector2 target) {
+    int index = agents.DenseIndex(handle);
+    if (index < 0) return false;
+    agents.target[index] = target;
+    agents.RequestPath(index);
+    commandProcessor.LogEdit(agents.tick);
+    return true;
 }
 
-void AgentManager::RespawnAgent(Agent& agent) {
-    Vector2 start;
-    do {
-        start = {(float)GetRandomValue(0, grid->GetWidth() - 1), 
-                (float)GetRandomValue(0, grid->GetHeight() - 1)};
-    } while (!grid->IsWalkable((int)start.x, (int)start.y));
+// Acorda agentes que dormem quando o grid muda. Blocked acorda com qualquer mudança (um
+// caminho pode ter aberto em qualquer lugar); Arrived só se alguma célula alterada estiver
+// a até WAKE_RADIUS da sua. Só percorre os agentes nos passos em que o grid mudou; se o
+// log de alterações foi descartado, acorda todos.
+bool AgentManager::WakeAgentsNearGridChanges() {
+    dirtyCells.clear();
+    bool complete = grid->CollectDirtyCells(gridCursor, dirtyCells);
+    if (complete && dirtyCells.empty()) return false;
     
-    Vector2 worldStart = {start.x * grid->GetCellSize() + grid->GetCellSize() / 2, 
-                         start.y * grid->GetCellSize() + grid->GetCellSize() / 2};
-    agent.SetPosition(worldStart);
-}
-
-void AgentManager::CheckCollision(std::unordered_map<int, int> &collMap, std::unordered_map<int, int> &broadCollMap) {
-    for(size_t i = 0; i < agents.size(); i++) {
-        for(size_t j = i + 1; j < agents.size(); j++) {
-            float dx = agents[i].GetPosition().x - agents[j].GetPosition().x;
-            float dy = agents[i].GetPosition().y - agents[j].GetPosition().y;
-            float distSq = dx * dx + dy * dy;
-
-            float broadRadiusSum = agents[i].DEFAULT_BROAD_RADIUS + agents[j].DEFAULT_BROAD_RADIUS;
-            float broadRadiusSumSq = broadRadiusSum * broadRadiusSum;
-
-            if(distSq <= broadRadiusSumSq) {
-                broadCollMap.insert({i, j});
-                printf("Colisão maior detectada entre %d e %d\n\n", i, j);
-                float collisionRadiusSum = agents[i].DEFAULT_COLLISION_RADIUS + agents[j].DEFAULT_COLLISION_RADIUS;
-                float collisionRadiusSumSq = collisionRadiusSum * collisionRadiusSum;
-                if(distSq <= collisionRadiusSumSq) {
-                    collMap.insert({i, j});
-                    printf("Colisão menor detectada entre %d e %d\n\n", i, j);
+    const int width = grid->GetWidth();
+    const int height = grid->GetHeight();
+    if (complete) {
+        wakeMask.assign(width * height, 0);
+        for (int cell : dirtyCells) {
+            int x = cell % width;
+            int y = cell / width;
+            for (int ny = std::max(0, y - WAKE_RADIUS); ny <= std::min(height - 1, y + WAKE_RADIUS); ny++) {
+                for (int nx = std::max(0, x - WAKE_RADIUS); nx <= std::min(width - 1, x + WAKE_RADIUS); nx++) {
+                    wakeMask[ny * width + nx] = 1;
                 }
             }
         }
     }
+    
+    const float cellSize = grid->GetCellSize();
+    for (int i = 0; i < agents.Size(); i++) {
+        AgentState state = agents.state[i];
+        if (!IsSleeping(state)) continue;
+        if (state == AgentState::Arrived && complete) {
+            int x = std::clamp((int)(agents.positionX[i] / cellSize), 0, width - 1);
+            int y = std::clamp((int)(agents.positionY[i] / cellSize), 0, height - 1);
+            if (!wakeMask[y * width + x]) continue;
+        }
+        agents.Wake(i);
+    }
+    return true;
+}
+
+void AgentManager::BuildNeighborHash() {
+    neighborX.clear();
+    neighborY.clear();
+    neighborBroad.clear();
+    neighborColl.clear();
+    neighborHandle.clear();
+    for (int index : agents.active) {
+        neighborX.push_back(agents.positionX[index]);
+        neighborY.push_back(agents.positionY[index]);
+        neighborBroad.push_back(agents.broadRadius[index]);
+        neighborColl.push_back(agents.collRadius[index]);
+        neighborHandle.push_back(agents.handle[index]);
+    }
+    neighborHash.Build(neighborX.data(), neighborY.data(), neighborBroad.data(), neighborColl.data(),
+                       neighborHandle.data(), (int)neighborHandle.size(),
+                       grid->GetWidth() * grid->GetCellSize(), grid->GetHeight() * grid->GetCellSize());
 }
 
+// Transforma o deslocamento pedido pelo comportamento num comando MoveAgent. Com a evitação
+// ligada, o deslocamento vira velocidade preferida e passa pelo ORCA; se o desvio levaria
+// o agente para uma célula bloqueada, fica o deslocamento original (que segue o caminho).
+// A velocidade nova vai para nextVelocity, para não alterar o que outras threads leem.
+void AgentManager::EmitMove(int index, float delta_time, CommandBuffer& buffer) {
+    float stepX = agents.stepX[index];
+    float stepY = agents.stepY[index];
+    agents.stepX[index] = 0.0f;
+    agents.stepY[index] = 0.0f;
+    if ((stepX == 0.0f && stepY == 0.0f) || delta_time <= 0.0f) {
+        nextVelocity[index] = {0.0f, 0.0f};
+        return;
+    }
+    
+    const float x = agents.positionX[index];
+    const float y = agents.positionY[index];
+    if (steeringEnabled) {
+        Vector2 velocity = steering.ComputeVelocity(agents, neighborHash, index,
+                                                    {stepX / delta_time, stepY / delta_time}, delta_time);
+        float steeredX = x + velocity.x * delta_time;
+        float steeredY = y + velocity.y * delta_time;
+        float steeredSq = (steeredX - x) * (steeredX - x) + (steeredY - y) * (steeredY - y);
+        float stall = STALL_FRACTION * STALL_FRACTION * (stepX * stepX + stepY * stepY);
+        if (steeredSq >= stall && grid->IsWalkable((int)(steeredX / grid->GetCellSize()), (int)(steeredY / grid->GetCellSize()))) {
+            stepX = steeredX - x;
+            stepY = steeredY - y;
+        }
+    }
+    
+    nextVelocity[index] = {stepX / delta_time, stepY / delta_time};
+    buffer.AddCommand(Command::Move(agents.handle[index], {x, y}, {x + stepX, y + stepY}));
+}
+
+// Atualiza uma sequência de agentes com o mesmo comportamento. Para os estáticos o tipo é
+// resolvido uma vez e o laço inteiro roda sem chamadas virtuais.
+void AgentManager::UpdateGroup(uint8_t kind, const int* indices, int count, float delta_time, CommandBuffer& buffer) {
+    if (kind == AgentStorage::DYNAMIC_BEHAVIOR) {
+        for (int n = 0; n < count; n++) {
+            Agent agent(agents, indices[n]);
+            agents.cold[indices[n]].behavior->Update(agent, *grid, delta_time, buffer);
+            EmitMove(indices[n], delta_time, buffer);
+        }
+        return;
+    }
+    
+    VisitStaticBehavior(kind, [&](auto behavior) {
+        const BehaviorContext context{*grid, delta_time, buffer};
+        for (int n = 0; n < count; n++) {
+            Agent agent(agents, indices[n]);
+            behavior.Update(behavior, agent, context);
+            EmitMove(indices[n], delta_time, buffer);
+        }
+    });
+}
+
+// Ordena a lista ativa por tipo de comportamento (counting sort estável), para que cada
+// bloco da atualização tenha poucas sequências longas do mesmo tipo.
+void AgentManager::GroupActiveByBehavior() {
+    const std::vector<int>& active = agents.active;
+    const int kindCount = (int)std::variant_size_v<StaticBehavior> + 1;
+    auto slotOf = [&](int index) {
+        uint8_t kind = agents.behaviorKind[index];
+        return kind == AgentStorage::DYNAMIC_BEHAVIOR ? kindCount - 1 : (int)kind;
+    };
+    
+    groupStart.assign(kindCount + 1, 0);
+    for (int index : active) {
+        groupStart[slotOf(index) + 1]++;
+    }
+    for (int kind = 0; kind < kindCount; kind++) {
+        groupStart[kind + 1] += groupStart[kind];
+    }
+    updateOrder.resize(active.size());
+    for (int index : active) {
+        updateOrder[groupStart[slotOf(index)]++] = index;
+    }
+}
+
+// Fase de atualização: só os agentes da lista ativa rodam, agrupados por comportamento,
+// em blocos paralelos no ThreadPool, cada um escrevendo no seu CommandBuffer (ver
+// contrato em IAgentBehavior).
+// Os buffers são juntados na ordem dos blocos, então a sequência de comandos é
+// determinística. Agentes que adormeceram saem da lista no fim do passo; como não se
+// movem mais, a posição anterior deles já é igual à atual.
+void AgentManager::UpdateAll(float delta_time, double time) {
+    simulationTime = time;
+    agents.tick++;
+    agents.steeringEnabled = steeringEnabled;
+    Metrics::SetAgentCount(agents.Size());
+    if (WakeAgentsNearGridChanges()) {
+        commandProcessor.LogEdit(agents.tick);
+    }
+    
+    const std::vector<int>& active = agents.active;
+    int count = (int)active.size();
+    for (int index : active) {
+        agents.previousX[index] = agents.positionX[index];
+        agents.previousY[index] = agents.positionY[index];
+    }
+    if (steeringEnabled) {
+        BuildNeighborHash();
+    }
+    nextVelocity.resize(agents.Size());
+    GroupActiveByBehavior();
+    
+    int chunkCount = ThreadPool::ChunkCount(count, UPDATE_CHUNK);
+    if ((int)chunkBuffers.size() < chunkCount) {
+        chunkBuffers.resize(chunkCount);
+    }
+    
+    ThreadPool::GetInstance().ParallelFor(count, UPDATE_CHUNK, [&](int begin, int end, int chunk) {
+        CommandBuffer& buffer = chunkBuffers[chunk];
+        for (int i = begin; i < end;) {
+            uint8_t kind = agents.behaviorKind[updateOrder[i]];
+            int runEnd = i + 1;
+            while (runEnd < end && agents.behaviorKind[updateOrder[runEnd]] == kind) runEnd++;
+            UpdateGroup(kind, updateOrder.data() + i, runEnd - i, delta_time, buffer);
+            i = runEnd;
+        }
+    });
+    
+    for (int index : active) {
+        agents.velocityX[index] = nextVelocity[index].x;
+        agents.velocityY[index] = nextVelocity[index].y;
+    }
+    
+    for (int chunk = 0; chunk < chunkCount; chunk++) {
+        commandProcessor.AddCommands(chunkBuffers[chunk]);
+    }
+    commandProcessor.ProcessCommands(simulationTime, commandExecutor);
+    agents.RemoveSleepingFromActive();
+}
+
+void AgentManager::RespawnAgent(Agent& agent) {
+    commandProcessor.AddCommand(Command::Respawn(agent.GetHandle(), simulationTime));
+}
+
+void AgentManager::SetCommandLog(CommandLogWriter* log) {
+    // Edições do grid anteriores ao log (o mapa montado antes de ligar) não são dele.
+    WakeAgentsNearGridChanges();
+    commandProcessor.SetCommandLog(log);
+}
+
+void AgentManager::SetCollisionDamageEnabled(bool enabled) {
+    collisionDamageEnabled = enabled;
+    if (enabled) {
+        collisionEvents.Subscribe(collisionDamage.get());
+    } else {
+        collisionEvents.Unsubscribe(collisionDamage.get());
+    }
+}
+
+// Broadphase por grade uniforme (ver SpatialHash): só agentes em células vizinhas são
+// comparados, então o custo cresce com o número de agentes e não com o de pares. Os
+// resultados saem como eventos em collisionEvents e são entregues aos assinantes
+// (dano, métricas, interface, log) depois que a fase de colisão termina.
+void AgentManager::CheckCollision() {
+    spatialHash.Build(agents.positionX.data(), agents.positionY.data(), agents.broadRadius.data(),
+                      agents.collRadius.data(), agents.handle.data(), agents.Size(),
+                      grid->GetWidth() * grid->GetCellSize(), grid->GetHeight() * grid->GetCellSize());
+    spatialHash.FindPairs(collisionEvents);
+    collisionEvents.Dispatch();
+    // Dano (e respawn) agendado pelos assinantes vale já neste passo.
+    commandProcessor.ProcessCommands(simulationTime, commandExecutor);
+}
+
+void AgentManager::SaveSnapshot(SnapshotWriter& out) const {
+    out.Write(simulationTime);
+    out.Write(collisionDamageEnabled);
+    out.Write(steeringEnabled);
+    out.Write(steering.GetSettings());
+    agents.SaveSnapshot(out);
+    commandProcessor.SaveSnapshot(out);
+}
+
+bool AgentManager::ReadSnapshot(SnapshotReader& in, SnapshotData& data) {
+    if (!in.Read(data.simulationTime) || !in.Read(data.collisionDamageEnabled) || !in.Read(data.steeringEnabled) ||
+        !in.Read(data.steeringSettings)) {
+        return false;
+    }
+    return data.agents.LoadSnapshot(in, &LoadBehaviorSnapshot, (int)std::variant_size<StaticBehavior>::value) &&
+           CommandProcessor::ReadSnapshot(in, data.commands);
+}
+
+void AgentManager::ApplySnapshot(SnapshotData& data) {
+    agents = std::move(data.agents);
+    commandProcessor.RestoreSnapshot(data.commands);
+    data.commands.clear();
+    
+    simulationTime = data.simulationTime;
+    SetCollisionDamageEnabled(data.collisionDamageEnabled);
+    steeringEnabled = data.steeringEnabled;
+    steering.SetSettings(data.steeringSettings);
+    for (int i = 0; i < agents.Size(); i++) {
+        agents.cold[i].observers.push_back(respawnObserver.get());
+    }
+    // O grid restaurado já reflete todas as edições anteriores ao snapshot.
+    grid->CollectDirtyCells(gridCursor, dirtyCells);
+    dirtyCells.clear();
+    commandProcessor.LogEdit(agents.tick);
+}
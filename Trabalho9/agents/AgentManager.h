@@ -1,21 +1,74 @@
 #pragma once
 #include "Agent.h"
+#include "StaticBehaviors.h"
+#include "AgentStorage.h"
 #include "Grid.h"
 #include "CommandProcessor.h"
+#include "CommandExecutor.h"
+#include "CommandBuffer.h"
 #include "AgentRespawnObserver.h"
+#include "SpatialHash.h"
+#include "OrcaSteering.h"
+#include "CollisionEventStream.h"
+#include "CollisionDamageSubscriber.h"
 #include <vector>
 #include <memory>
-#include <unordered_map>
 
 class AgentManager {
 private:
     static std::unique_ptr<AgentManager> instance;
-    std::vector<Agent> agents;
+    AgentStorage agents;
     Grid* grid;
     CommandProcessor commandProcessor;
+    CommandExecutor commandExecutor;
+    std::vector<CommandBuffer> chunkBuffers;
+    SpatialHash spatialHash;
+    CollisionEventStream collisionEvents;
+    std::unique_ptr<CollisionDamageSubscriber> collisionDamage;
     std::unique_ptr<AgentRespawnObserver> respawnObserver;
+    double simulationTime = 0.0;
+    bool collisionDamageEnabled = false;
+    
+    // Cursor no log de células alteradas do grid e buffers para acordar agentes perto delas.
+    uint64_t gridCursor = 0;
+    std::vector<int> dirtyCells;
+    std::vector<uint8_t> wakeMask;
+    
+    // Evitação local opcional entre o Update e a emissão dos comandos de movimento. A grade de
+    // vizinhos é própria, construída no início do passo só com os agentes ativos.
+    bool steeringEnabled = false;
+    OrcaSteering steering;
+    SpatialHash neighborHash;
+    std::vector<float> neighborX, neighborY, neighborBroad, neighborColl;
+    std::vector<AgentHandle> neighborHandle;
+    std::vector<Vector2> nextVelocity;
+    
+    // Lista ativa ordenada por tipo de comportamento (ver GroupActiveByBehavior).
+    std::vector<int> updateOrder;
+    std::vector<int> groupStart;
+    
+    // Retorna true se o grid mudou desde a última chamada.
+    bool WakeAgentsNearGridChanges();
+    void GroupActiveByBehavior();
+    void UpdateGroup(uint8_t kind, const int* indices, int count, float delta_time, CommandBuffer& buffer);
+    Agent AddAgentWithKind(Vector2 start, Vector2 target, uint8_t kind, std::unique_ptr<IAgentBehavior> behavior);
+    void BuildNeighborHash();
+    void EmitMove(int index, float delta_time, CommandBuffer& buffer);
     
 public:
+    // Agentes por bloco na atualização paralela. Fixo, para que a divisão em blocos
+    // (e a ordem dos comandos) não dependa do número de threads.
+    static constexpr int UPDATE_CHUNK = 256;
+    // Distância (Chebyshev, em células) até a qual uma mudança no grid acorda agentes que
+    // chegaram ao alvo.
+    static constexpr int WAKE_RADIUS = 2;
+    // Se a evitação local reduzir a velocidade abaixo desta fração da preferida, o agente
+    // segue o caminho mesmo assim: em corredores de uma célula não há como dois agentes se
+    // cruzarem, e esperar só travaria os dois.
+    static constexpr float STALL_FRACTION = 0.1f;
+    // Sorteios do alvo em SpawnAgents antes de aceitar alvo igual ao início.
+    static constexpr int SPAWN_TARGET_ATTEMPTS = 16;
+
     AgentManager(Grid* grid);
     
     AgentManager(const AgentManager&) = delete;
@@ -25,14 +78,69 @@ public:
     static AgentManager& CreateInstance(Grid* grid);
     static void DestroyInstance();
     
-    void AddAgent(Vector2 start, Vector2 target);
-    void AddAgentWithBehavior(Vector2 start, Vector2 target, std::unique_ptr<IAgentBehavior> behavior);
+    Agent AddAgent(Vector2 start, Vector2 target);
+    // Comportamento virtual, montado com decoradores em tempo de execução.
+    Agent AddAgentWithBehavior(Vector2 start, Vector2 target, std::unique_ptr<IAgentBehavior> behavior);
+    // Comportamento composto em tempo de compilação; atualizado em laços sem chamadas virtuais.
+    Agent AddAgentWithBehavior(Vector2 start, Vector2 target, const StaticBehavior& behavior);
     void AddRandomAgents(int count);
-    void UpdateAll(float delta_time);
-    void DrawAll(Grid& grid);
-    int GetAgentCount() const { return agents.size(); }
-    std::vector<Agent>& GetAgents() { return agents; }
+    // Cria `count` agentes em células livres sorteadas, com alvos também sorteados (na mesma
+    // componente conexa, se sameComponent). Retorna quantos criou: 0 num grid sem células livres.
+    int SpawnAgents(int count, const StaticBehavior& behavior = StaticBehavior{}, bool sameComponent = true);
+    // Avança um passo de delta_time; `time` é o tempo de simulação no fim dele, usado para
+    // agendar e executar comandos. A Simulation passa tick × fixedDelta, então o relógio
+    // dos comandos é o dela mesmo depois de trocar de gerenciador. Sem `time`, soma delta_time.
+    void UpdateAll(float delta_time, double time);
+    void UpdateAll(float delta_time) { UpdateAll(delta_time, simulationTime + delta_time); }
+    double GetSimulationTime() const { return simulationTime; }
+    
+    // Seed dos sorteios por agente (AgentRandom). Com o mesmo seed do mundo e o mesmo
+    // Random::Seed, uma execução se repete bit a bit com qualquer número de threads.
+    void SetWorldSeed(uint64_t seed) { agents.worldSeed = seed; }
+    uint64_t GetWorldSeed() const { return agents.worldSeed; }
+    uint32_t GetTick() const { return agents.tick; }
+    int GetAgentCount() const { return agents.Size(); }
+    int GetActiveAgentCount() const { return (int)agents.active.size(); }
+    Agent GetAgent(int index) { return Agent(agents, index); }
+    bool IsValid(AgentHandle handle) const { return agents.IsValid(handle); }
+    // Pré-condição: IsValid(handle).
+    Agent GetAgent(AgentHandle handle) { return Agent(agents, agents.DenseIndex(handle)); }
+    bool RemoveAgent(AgentHandle handle);
+    // Troca o alvo (em células) e acorda o agente para buscar um caminho novo.
+    bool SetTarget(AgentHandle handle, Vector2 target);
+    AgentStorage& GetStorage() { return agents; }
     CommandProcessor& GetCommandProcessor() { return commandProcessor; }
+    // Agenda um comando para executar a partir de executionTime (tempo de simulação).
+    void AddCommand(const Command& command) { commandProcessor.AddCommand(command); }
+    void UndoLastCommand() { commandProcessor.UndoLastCommand(commandExecutor); }
+    // Comandos executados vão para `log`; agentes criados ou removidos, desfazer, edições
+    // do grid e snapshots restaurados entram como edições (ver CommandLog).
+    void SetCommandLog(CommandLogWriter* log);
+    // Agenda a volta do agente morto numa célula livre sorteada (RespawnAgent).
     void RespawnAgent(Agent& agent);
-    void CheckCollision(std::unordered_map<int, int> &collMap, std::unordered_map<int, int> &broadCollMap);
-};
\ No newline at end of file
+    CollisionEventStream& GetCollisionEvents() { return collisionEvents; }
+    void SetCollisionDamageEnabled(bool enabled);
+    bool IsCollisionDamageEnabled() const { return collisionDamageEnabled; }
+    void SetSteeringEnabled(bool enabled) { steeringEnabled = enabled; }
+    bool IsSteeringEnabled() const { return steeringEnabled; }
+    OrcaSteering& GetSteering() { return steering; }
+    void CheckCollision();
+    
+    // Agentes (com caminhos, cursores e composição dos comportamentos), configuração da
+    // simulação e fila de comandos pendentes. Não pode ser chamada durante UpdateAll.
+    void SaveSnapshot(SnapshotWriter& out) const;
+    
+    // Estado lido e validado de um snapshot, ainda não aplicado.
+    struct SnapshotData {
+        double simulationTime = 0.0;
+        bool collisionDamageEnabled = false;
+        bool steeringEnabled = false;
+        SteeringSettings steeringSettings;
+        AgentStorage agents;
+        std::vector<Command> commands;
+    };
+    // Retorna false se os dados forem inválidos; não mexe em nenhum gerenciador.
+    static bool ReadSnapshot(SnapshotReader& in, SnapshotData& data);
+    // Substitui o estado pelo lido; o grid já deve ter sido restaurado. `data` fica vazio.
+    void ApplySnapshot(SnapshotData& data);
+};
@@ -0,0 +1,28 @@
+#pragma once
+#include "CounterRng.h"
+#include "AgentHandle.h"
+#include <cstdint>
+
+// Sorteios de um agente como função pura de (seed do mundo, agente, tick, sorteio): o
+// fluxo vem do handle (slot e geração) e o contador do tick mais o número do sorteio no
+// tick. Não há estado compartilhado, então comportamentos podem sortear durante a fase
+// paralela de UpdateAll em qualquer thread e o resultado não depende da ordem dos
+// chunks nem do número de threads.
+//
+// Cada chamada com o mesmo `draw` no mesmo tick devolve o mesmo valor; quem precisa de
+// vários números num passo usa draws diferentes.
+class AgentRandom {
+private:
+    CounterRng rng;
+    uint32_t tick;
+
+public:
+    AgentRandom(uint64_t worldSeed, AgentHandle agent, uint32_t tick)
+        : rng(worldSeed, ((uint64_t)agent.generation << 32) | agent.index), tick(tick) {}
+
+    uint32_t Bits(uint32_t draw) const { return rng.At(tick, draw); }
+    // Real uniforme em [0, 1).
+    float Uniform(uint32_t draw) const { return rng.UniformAt(tick, draw); }
+    // Inteiro uniforme em [min, max].
+    int Range(uint32_t draw, int min, int max) const { return rng.RangeAt(tick, draw, min, max); }
+};
@@ -0,0 +1,16 @@
+#pragma once
+#include <cstdint>
+
+// Estado de um agente na máquina de estados da atualização. WaitingForPath e Moving
+// ficam na lista de agentes ativos e rodam Update a cada passo; Arrived e Blocked dormem
+// e não custam nada até serem acordados (novo alvo, dano ou mudança no grid).
+enum class AgentState : uint8_t {
+    WaitingForPath,  // precisa de um caminho novo até o alvo
+    Moving,          // seguindo o caminho atual
+    Arrived,         // chegou ao alvo; acorda com mudanças no grid perto dele
+    Blocked          // não há caminho até o alvo; acorda com qualquer mudança no grid
+};
+
+inline bool IsSleeping(AgentState state) {
+    return state == AgentState::Arrived || state == AgentState::Blocked;
+}
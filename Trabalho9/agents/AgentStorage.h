@@ -0,0 +1,395 @@
+#pragma once
+#include "NavTypes.h"
+#include "behaviors/IAgentBehavior.h"
+#include "IObserver.h"
+#include "AgentHandle.h"
+#include "AgentState.h"
+#include "AgentRandom.h"
+#include "Snapshot.h"
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+// Dados raramente acessados no laço de atualização.
+struct AgentColdData {
+    Color color;
+    std::vector<Vector2> path;
+    std::unique_ptr<IAgentBehavior> behavior;
+    std::vector<IObserver*> observers;
+};
+
+// Armazenamento dos agentes em estrutura de arrays (SoA): cada campo quente fica num
+// vetor contíguo, indexado pela posição do agente. Laços que só tocam posições e raios
+// percorrem memória linear e podem ser vetorizados pelo compilador.
+//
+// Os arrays densos ficam sempre compactos (remoção troca com o último), então o índice
+// denso de um agente muda quando outro é removido. Referências que atravessam quadros
+// (comandos, eventos) usam AgentHandle, resolvido pela tabela de slots em O(1). Slots
+// livres são reaproveitados pela free list e os vetores mantêm a capacidade, então
+// criar e remover agentes em massa não realoca memória depois do primeiro pico.
+//
+// `active` lista os índices densos dos agentes acordados (ver AgentState); activeSlot
+// guarda a posição de cada agente nessa lista (-1 se dorme). A lista só muda fora da
+// fase paralela da atualização.
+struct AgentStorage {
+    static constexpr float MAX_LIFE = 100.0f;
+    // behaviorKind de agentes com comportamento virtual (cold.behavior); os demais guardam
+    // o índice do tipo em StaticBehavior.
+    static constexpr uint8_t DYNAMIC_BEHAVIOR = 255;
+    
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    // Posição no início do último passo da simulação, para interpolar o desenho.
+    std::vector<float> previousX;
+    std::vector<float> previousY;
+    std::vector<Vector2> target;
+    // Deslocamento pedido pelo comportamento no passo atual (ver Agent::RequestMove) e
+    // velocidade aplicada no último passo, em pixels por segundo.
+    std::vector<float> stepX;
+    std::vector<float> stepY;
+    std::vector<float> velocityX;
+    std::vector<float> velocityY;
+    std::vector<float> speed;
+    std::vector<int> pathIndex;
+    std::vector<AgentState> state;
+    std::vector<int> activeSlot;
+    std::vector<float> life;
+    std::vector<float> collRadius;
+    std::vector<float> broadRadius;
+    std::vector<uint8_t> behaviorKind;
+    
+    std::vector<AgentColdData> cold;
+    std::vector<AgentHandle> handle;
+    
+    // Tabela de slots: índice denso (-1 se livre) e geração atual de cada slot.
+    std::vector<int> slotDense;
+    std::vector<uint32_t> slotGeneration;
+    std::vector<uint32_t> freeSlots;
+    
+    std::vector<int> active;
+    
+    // Chave dos sorteios por agente (ver AgentRandom): seed do mundo e passo atual.
+    uint64_t worldSeed = 0;
+    uint32_t tick = 0;
+    // Evitação local ligada no passo atual (copiado do AgentManager no início de UpdateAll).
+    bool steeringEnabled = false;
+    
+    int Size() const { return (int)positionX.size(); }
+    
+    bool IsValid(AgentHandle agentHandle) const {
+        return agentHandle.index < slotDense.size() && slotDense[agentHandle.index] >= 0 &&
+               slotGeneration[agentHandle.index] == agentHandle.generation;
+    }
+    
+    // Índice denso atual do agente, ou -1 se o handle não vale mais.
+    int DenseIndex(AgentHandle agentHandle) const {
+        return IsValid(agentHandle) ? slotDense[agentHandle.index] : -1;
+    }
+    
+    int Add(Vector2 position, Vector2 agentTarget, float agentSpeed, float collisionRadius, float broadPhaseRadius,
+            Color color, uint8_t kind, std::unique_ptr<IAgentBehavior> behavior) {
+        uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = (uint32_t)slotDense.size();
+            slotDense.push_back(-1);
+            slotGeneration.push_back(0);
+        }
+        slotDense[slot] = Size();
+        handle.push_back({slot, slotGeneration[slot]});
+        
+        positionX.push_back(position.x);
+        positionY.push_back(position.y);
+        previousX.push_back(position.x);
+        previousY.push_back(position.y);
+        target.push_back(agentTarget);
+        stepX.push_back(0.0f);
+        stepY.push_back(0.0f);
+        velocityX.push_back(0.0f);
+        velocityY.push_back(0.0f);
+        speed.push_back(agentSpeed);
+        pathIndex.push_back(0);
+        state.push_back(AgentState::WaitingForPath);
+        activeSlot.push_back(-1);
+        life.push_back(MAX_LIFE);
+        collRadius.push_back(collisionRadius);
+        broadRadius.push_back(broadPhaseRadius);
+        behaviorKind.push_back(behavior ? DYNAMIC_BEHAVIOR : kind);
+        cold.push_back({color, {}, std::move(behavior), {}});
+        Activate(Size() - 1);
+        return Size() - 1;
+    }
+    
+    AgentRandom RandomFor(int dense) const {
+        return AgentRandom(worldSeed, handle[dense], tick);
+    }
+    
+    // Reserva espaço para `count` agentes em todos os arrays (criação em massa).
+    void Reserve(int count) {
+        positionX.reserve(count);
+        positionY.reserve(count);
+        previousX.reserve(count);
+        previousY.reserve(count);
+        target.reserve(count);
+        stepX.reserve(count);
+        stepY.reserve(count);
+        velocityX.reserve(count);
+        velocityY.reserve(count);
+        speed.reserve(count);
+        pathIndex.reserve(count);
+        state.reserve(count);
+        activeSlot.reserve(count);
+        life.reserve(count);
+        collRadius.reserve(count);
+        broadRadius.reserve(count);
+        behaviorKind.reserve(count);
+        cold.reserve(count);
+        handle.reserve(count);
+        active.reserve(count);
+        slotDense.reserve(count);
+        slotGeneration.reserve(count);
+    }
+    
+    // Acorda um agente que dorme para que recalcule o caminho; agentes acordados não mudam.
+    void Wake(int dense) {
+        if (IsSleeping(state[dense])) {
+            state[dense] = AgentState::WaitingForPath;
+        }
+        Activate(dense);
+    }
+    
+    // Descarta o caminho atual: o agente calcula outro no próximo passo.
+    void RequestPath(int dense) {
+        state[dense] = AgentState::WaitingForPath;
+        Activate(dense);
+    }
+    
+    // Tira da lista ativa os agentes que adormeceram no último passo.
+    void RemoveSleepingFromActive() {
+        for (int i = 0; i < (int)active.size();) {
+            if (IsSleeping(state[active[i]])) {
+                Deactivate(active[i]);
+            } else {
+                i++;
+            }
+        }
+    }
+    
+    bool Remove(AgentHandle agentHandle) {
+        int dense = DenseIndex(agentHandle);
+        if (dense < 0) return false;
+        
+        Deactivate(dense);
+        int last = Size() - 1;
+        if (dense != last) {
+            positionX[dense] = positionX[last];
+            positionY[dense] = positionY[last];
+            previousX[dense] = previousX[last];
+            previousY[dense] = previousY[last];
+            target[dense] = target[last];
+            stepX[dense] = stepX[last];
+            stepY[dense] = stepY[last];
+            velocityX[dense] = velocityX[last];
+            velocityY[dense] = velocityY[last];
+            speed[dense] = speed[last];
+            pathIndex[dense] = pathIndex[last];
+            state[dense] = state[last];
+            activeSlot[dense] = activeSlot[last];
+            life[dense] = life[last];
+            collRadius[dense] = collRadius[last];
+            broadRadius[dense] = broadRadius[last];
+            behaviorKind[dense] = behaviorKind[last];
+            cold[dense] = std::move(cold[last]);
+            handle[dense] = handle[last];
+            slotDense[handle[dense].index] = dense;
+            if (activeSlot[dense] >= 0) active[activeSlot[dense]] = dense;
+        }
+        PopBack();
+        
+        ReleaseSlot(agentHandle.index);
+        return true;
+    }
+    
+    // Grava todos os arrays, a tabela de slots e a lista ativa, então handles gravados em
+    // outros lugares (comandos pendentes) continuam válidos depois de LoadSnapshot. Os
+    // observadores não entram no snapshot.
+    void SaveSnapshot(SnapshotWriter& out) const {
+        out.Write(worldSeed);
+        out.Write(tick);
+        out.WriteVector(positionX);
+        out.WriteVector(positionY);
+        out.WriteVector(previousX);
+        out.WriteVector(previousY);
+        out.WriteVector(target);
+        out.WriteVector(stepX);
+        out.WriteVector(stepY);
+        out.WriteVector(velocityX);
+        out.WriteVector(velocityY);
+        out.WriteVector(speed);
+        out.WriteVector(pathIndex);
+        out.WriteVector(state);
+        out.WriteVector(activeSlot);
+        out.WriteVector(life);
+        out.WriteVector(collRadius);
+        out.WriteVector(broadRadius);
+        out.WriteVector(behaviorKind);
+        out.WriteVector(handle);
+        for (const AgentColdData& data : cold) {
+            out.Write(data.color);
+            out.WriteVector(data.path);
+            out.Write<uint8_t>(data.behavior ? 1 : 0);
+            if (data.behavior) data.behavior->SaveSnapshot(out);
+        }
+        out.WriteVector(slotDense);
+        out.WriteVector(slotGeneration);
+        out.WriteVector(freeSlots);
+        out.WriteVector(active);
+    }
+    
+    // Cria um comportamento virtual a partir do snapshot (ver LoadBehaviorSnapshot).
+    using BehaviorLoader = std::unique_ptr<IAgentBehavior> (*)(SnapshotReader& in, int depth);
+    
+    // Substitui todos os agentes pelos do snapshot. Se os dados forem inválidos ou
+    // inconsistentes retorna false e não muda nada. Os agentes voltam sem observadores.
+    bool LoadSnapshot(SnapshotReader& in, BehaviorLoader loadBehavior, int staticKindCount) {
+        AgentStorage loaded;
+        bool ok = in.Read(loaded.worldSeed) && in.Read(loaded.tick) &&
+                  in.ReadVector(loaded.positionX) && in.ReadVector(loaded.positionY) &&
+                  in.ReadVector(loaded.previousX) && in.ReadVector(loaded.previousY) &&
+                  in.ReadVector(loaded.target) && in.ReadVector(loaded.stepX) && in.ReadVector(loaded.stepY) &&
+                  in.ReadVector(loaded.velocityX) && in.ReadVector(loaded.velocityY) &&
+                  in.ReadVector(loaded.speed) && in.ReadVector(loaded.pathIndex) && in.ReadVector(loaded.state) &&
+                  in.ReadVector(loaded.activeSlot) && in.ReadVector(loaded.life) &&
+                  in.ReadVector(loaded.collRadius) && in.ReadVector(loaded.broadRadius) &&
+                  in.ReadVector(loaded.behaviorKind) && in.ReadVector(loaded.handle);
+        if (!ok) return false;
+        
+        const size_t count = loaded.positionX.size();
+        for (size_t size : {loaded.positionY.size(), loaded.previousX.size(), loaded.previousY.size(),
+                            loaded.target.size(), loaded.stepX.size(), loaded.stepY.size(),
+                            loaded.velocityX.size(), loaded.velocityY.size(), loaded.speed.size(),
+                            loaded.pathIndex.size(), loaded.state.size(), loaded.activeSlot.size(),
+                            loaded.life.size(), loaded.collRadius.size(), loaded.broadRadius.size(),
+                            loaded.behaviorKind.size(), loaded.handle.size()}) {
+            if (size != count) return in.Fail();
+        }
+        
+        loaded.cold.resize(count);
+        for (AgentColdData& data : loaded.cold) {
+            uint8_t hasBehavior;
+            if (!in.Read(data.color) || !in.ReadVector(data.path) || !in.Read(hasBehavior)) return false;
+            if (hasBehavior) {
+                data.behavior = loadBehavior(in, 0);
+                if (!data.behavior) return in.Fail();
+            }
+        }
+        
+        ok = in.ReadVector(loaded.slotDense) && in.ReadVector(loaded.slotGeneration) &&
+             in.ReadVector(loaded.freeSlots) && in.ReadVector(loaded.active);
+        if (!ok) return false;
+        if (!loaded.IsConsistent(staticKindCount)) return in.Fail();
+        
+        *this = std::move(loaded);
+        return true;
+    }
+    
+    // Confere a tabela de slots, a lista ativa e os índices guardados nos arrays.
+    bool IsConsistent(int staticKindCount) const {
+        const int count = Size();
+        if (slotGeneration.size() != slotDense.size() || freeSlots.size() + count != slotDense.size()) return false;
+        
+        for (int i = 0; i < count; i++) {
+            const AgentHandle& agentHandle = handle[i];
+            if (agentHandle.index >= slotDense.size() || slotDense[agentHandle.index] != i ||
+                slotGeneration[agentHandle.index] != agentHandle.generation) {
+                return false;
+            }
+            uint8_t kind = behaviorKind[i];
+            if (kind == DYNAMIC_BEHAVIOR ? !cold[i].behavior : (kind >= staticKindCount || cold[i].behavior)) return false;
+            if (pathIndex[i] < 0 || pathIndex[i] > (int)cold[i].path.size()) return false;
+            if (activeSlot[i] >= (int)active.size() || (activeSlot[i] >= 0 && active[activeSlot[i]] != i)) return false;
+        }
+        for (int slot = 0; slot < (int)active.size(); slot++) {
+            if (active[slot] < 0 || active[slot] >= count || activeSlot[active[slot]] != slot) return false;
+        }
+        for (uint32_t slot : freeSlots) {
+            if (slot >= slotDense.size() || slotDense[slot] != -1) return false;
+        }
+        return true;
+    }
+    
+    void Clear() {
+        for (const AgentHandle& agentHandle : handle) {
+            ReleaseSlot(agentHandle.index);
+        }
+        handle.clear();
+        positionX.clear();
+        positionY.clear();
+        previousX.clear();
+        previousY.clear();
+        target.clear();
+        stepX.clear();
+        stepY.clear();
+        velocityX.clear();
+        velocityY.clear();
+        speed.clear();
+        pathIndex.clear();
+        state.clear();
+        activeSlot.clear();
+        active.clear();
+        life.clear();
+        collRadius.clear();
+        broadRadius.clear();
+        behaviorKind.clear();
+        cold.clear();
+    }
+    
+private:
+    void Activate(int dense) {
+        if (activeSlot[dense] >= 0) return;
+        activeSlot[dense] = (int)active.size();
+        active.push_back(dense);
+    }
+    
+    // Troca com o último da lista ativa; a ordem da lista não importa para o resultado,
+    // só precisa ser a mesma em execuções iguais.
+    void Deactivate(int dense) {
+        int slot = activeSlot[dense];
+        if (slot < 0) return;
+        int moved = active.back();
+        active[slot] = moved;
+        activeSlot[moved] = slot;
+        active.pop_back();
+        activeSlot[dense] = -1;
+    }
+    
+    void ReleaseSlot(uint32_t slot) {
+        slotDense[slot] = -1;
+        slotGeneration[slot]++;
+        freeSlots.push_back(slot);
+    }
+    
+    void PopBack() {
+        positionX.pop_back();
+        positionY.pop_back();
+        previousX.pop_back();
+        previousY.pop_back();
+        target.pop_back();
+        stepX.pop_back();
+        stepY.pop_back();
+        velocityX.pop_back();
+        velocityY.pop_back();
+        speed.pop_back();
+        pathIndex.pop_back();
+        state.pop_back();
+        activeSlot.pop_back();
+        life.pop_back();
+        collRadius.pop_back();
+        broadRadius.pop_back();
+        behaviorKind.pop_back();
+        cold.pop_back();
+        handle.pop_back();
+    }
+};
@@ -10,17 +10,11 @@ public:
     AgentDecorator(std::unique_ptr<IAgentBehavior> behavior) 
         : wrappedBehavior(std::move(behavior)) {}
     
-    void Update(Agent& agent, Grid& grid, Vector2& target, std::vector<Vector2>& path, 
-               bool& has_path, int& currentPathIndex, float delta_time, CommandProcessor& commandProcessor) override {
-        wrappedBehavior->Update(agent, grid, target, path, has_path, currentPathIndex, delta_time, commandProcessor);
+    void Update(Agent& agent, Grid& grid, float delta_time, CommandBuffer& commandBuffer) override {
+        wrappedBehavior->Update(agent, grid, delta_time, commandBuffer);
     }
     
-    void Draw(Grid& grid, Vector2 position, Color color) override {
-        wrappedBehavior->Draw(grid, position, color);
+    void FindPath(Agent& agent, Grid& grid, int minClearance) override {
+        wrappedBehavior->FindPath(agent, grid, minClearance);
     }
-    
-    void FindPath(Grid& grid, Vector2 position, Vector2 target, 
-                 std::vector<Vector2>& path, bool& has_path, int& currentPathIndex) override {
-        wrappedBehavior->FindPath(grid, position, target, path, has_path, currentPathIndex);
-    }
-};
\ No newline at end of file
+};
@@ -0,0 +1,33 @@
+#pragma once
+#include "BasicAgentBehavior.h"
+#include "SmartPathfindingDecorator.h"
+#include "SpeedBoostDecorator.h"
+#include "Snapshot.h"
+#include <memory>
+
+// Monta de novo a cadeia de decoradores gravada por IAgentBehavior::SaveSnapshot.
+// Retorna nullptr se a camada for desconhecida ou a cadeia passar de MAX_LAYERS.
+inline std::unique_ptr<IAgentBehavior> LoadBehaviorSnapshot(SnapshotReader& in, int depth = 0) {
+    constexpr int MAX_LAYERS = 16;
+    BehaviorLayer layer;
+    if (depth >= MAX_LAYERS || !in.Read(layer)) return nullptr;
+    
+    switch (layer) {
+        case BehaviorLayer::Basic:
+            return std::make_unique<BasicAgentBehavior>();
+        case BehaviorLayer::SmartPathfinding: {
+            auto wrapped = LoadBehaviorSnapshot(in, depth + 1);
+            if (!wrapped) return nullptr;
+            return std::make_unique<SmartPathfindingDecorator>(std::move(wrapped));
+        }
+        case BehaviorLayer::SpeedBoost: {
+            float multiplier;
+            if (!in.Read(multiplier)) return nullptr;
+            auto wrapped = LoadBehaviorSnapshot(in, depth + 1);
+            if (!wrapped) return nullptr;
+            return std::make_unique<SpeedBoostDecorator>(std::move(wrapped), multiplier);
+        }
+    }
+    in.Fail();
+    return nullptr;
+}
@@ -1,18 +1,33 @@
 #pragma once
-#include "raylib.h"
 #include "Grid.h"
+#include "Snapshot.h"
 #include <vector>
 
-class CommandProcessor;
+class CommandBuffer;
 class Agent;
 
+// Camadas de um comportamento virtual num snapshot, da mais externa para a base.
+enum class BehaviorLayer : uint8_t {
+    Basic,
+    SmartPathfinding,
+    SpeedBoost
+};
+
+// Contrato de concorrência: AgentManager::UpdateAll chama Update de vários agentes ao mesmo
+// tempo, em threads diferentes. Durante Update (e FindPath) um comportamento pode:
+//   - ler o Grid (nunca alterá-lo: nada de SetOccupied/SetWalkable/SetTerrainCost);
+//   - ler e escrever os dados do próprio agente (caminho, índice do caminho, alvo);
+//   - pedir movimento com Agent::RequestMove (vira um comando MoveAgent depois da
+//     evitação local) ou emitir comandos no CommandBuffer recebido, exclusivo do bloco.
+// Qualquer outra mudança de estado (posição, vida, outros agentes, o RNG global Random)
+// deve ser feita por um comando, executado depois em ProcessCommands.
 class IAgentBehavior {
 public:
     virtual ~IAgentBehavior() = default;
     
-    virtual void Update(Agent& agent, Grid& grid, Vector2& target, std::vector<Vector2>& path, 
-                       bool& has_path, int& currentPathIndex, float delta_time, CommandProcessor& commandProcessor) = 0;
-    virtual void Draw(Grid& grid, Vector2 position, Color color) = 0;
-    virtual void FindPath(Grid& grid, Vector2 position, Vector2 target, 
-                         std::vector<Vector2>& path, bool& has_path, int& currentPathIndex) = 0;
-};
\ No newline at end of file
+    virtual void Update(Agent& agent, Grid& grid, float delta_time, CommandBuffer& commandBuffer) = 0;
+    virtual void FindPath(Agent& agent, Grid& grid, int minClearance) = 0;
+    // Grava a composição (camada e parâmetros, depois a camada embrulhada); lida de volta
+    // por LoadBehaviorSnapshot.
+    virtual void SaveSnapshot(SnapshotWriter& out) const = 0;
+};
@@ -6,9 +6,13 @@ public:
     SmartPathfindingDecorator(std::unique_ptr<IAgentBehavior> behavior)
         : AgentDecorator(std::move(behavior)) {}
     
-    void FindPath(Grid& grid, Vector2 position, Vector2 target, 
-                 std::vector<Vector2>& path, bool& has_path, int& currentPathIndex) override {
+    void FindPath(Agent& agent, Grid& grid, int minClearance) override {
         //printf("Usando pathfinding inteligente!\n");
-        AgentDecorator::FindPath(grid, position, target, path, has_path, currentPathIndex);
+        AgentDecorator::FindPath(agent, grid, minClearance);
     }
-};
\ No newline at end of file
+    
+    void SaveSnapshot(SnapshotWriter& out) const override {
+        out.Write(BehaviorLayer::SmartPathfinding);
+        wrappedBehavior->SaveSnapshot(out);
+    }
+};
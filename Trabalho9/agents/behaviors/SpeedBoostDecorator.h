@@ -6,11 +6,16 @@ private:
     float speedMultiplier;
     
 public:
-    SpeedBoostDecorator(std::unique_ptr<IAgentBehavior> behavior, float multiplier = 1.5f)
+    SpeedBoostDecorator(std::unique_ptr<IAgentBehavior> behavior, float multiplier = 2.0f)
         : AgentDecorator(std::move(behavior)), speedMultiplier(multiplier) {}
     
-    void Update(Agent& agent, Grid& grid, Vector2& target, std::vector<Vector2>& path, 
-               bool& has_path, int& currentPathIndex, float delta_time, CommandProcessor& commandProcessor) override {
-        AgentDecorator::Update(agent, grid, target, path, has_path, currentPathIndex, delta_time * speedMultiplier, commandProcessor);
+    void Update(Agent& agent, Grid& grid, float delta_time, CommandBuffer& commandBuffer) override {
+        AgentDecorator::Update(agent, grid, delta_time * speedMultiplier, commandBuffer);
     }
-};
\ No newline at end of file
+    
+    void SaveSnapshot(SnapshotWriter& out) const override {
+        out.Write(BehaviorLayer::SpeedBoost);
+        out.Write(speedMultiplier);
+        wrappedBehavior->SaveSnapshot(out);
+    }
+};
@@ -0,0 +1,179 @@
+#pragma once
+#include "Agent.h"
+#include "AStarPathfinder.h"
+#include "CommandBuffer.h"
+#include <cmath>
+#include <cstdint>
+#include <ratio>
+#include <utility>
+#include <variant>
+
+// Comportamentos compostos em tempo de compilação. Em vez de uma cadeia de decoradores
+// virtuais, cada camada é um mixin que herda da camada de baixo, por exemplo
+// SpeedBoost<SmartPathfinding<BasicBehavior>>. As camadas não têm estado (os dados do
+// agente ficam em AgentStorage), então AgentManager agrupa os agentes pelo tipo de
+// comportamento e atualiza cada grupo num laço sem chamadas virtuais.
+//
+// Update recebe `self`, a camada mais externa, para que FindPath chamado de dentro de
+// BasicBehavior chegue às camadas de cima. Vale o mesmo contrato de concorrência de
+// IAgentBehavior.
+
+struct BehaviorContext {
+    Grid& grid;
+    float deltaTime;
+    CommandBuffer& commands;
+};
+
+struct BasicBehavior {
+    template <class Self>
+    void Update(Self& self, Agent& agent, const BehaviorContext& context) const {
+        Grid& grid = context.grid;
+        
+        if (agent.GetState() == AgentState::WaitingForPath) {
+            //printf("Agent has no path - calling FindPath...\n");
+            self.FindPath(agent, grid, grid.ClearanceForRadius(agent.getCollisionRadius()));
+            return;
+        }
+        if (!agent.HasPath()) return;
+        
+        std::vector<Vector2>& path = agent.Path();
+        int& currentPathIndex = agent.PathIndex();
+        
+        // Um ponto do caminho conta como alcançado a menos de 5 px do centro da célula. Com a
+        // evitação local ligada basta entrar na célula, porque outro agente pode estar
+        // ocupando o centro. Ao alcançar um ponto o agente já segue para o próximo no mesmo
+        // passo.
+        const bool steering = agent.GetStorage().steeringEnabled;
+        Vector2 position = agent.GetPosition();
+        while (currentPathIndex < (int)path.size()) {
+            Vector2 nextCell = path[currentPathIndex];
+            Vector2 targetWorldPos = {nextCell.x * grid.GetCellSize() + grid.GetCellSize() / 2, 
+                                     nextCell.y * grid.GetCellSize() + grid.GetCellSize() / 2};
+            
+            Vector2 direction = {targetWorldPos.x - position.x, targetWorldPos.y - position.y};
+            float distance = sqrt(direction.x * direction.x + direction.y * direction.y);
+            bool insideCell = steering && (int)(position.x / grid.GetCellSize()) == (int)nextCell.x &&
+                              (int)(position.y / grid.GetCellSize()) == (int)nextCell.y;
+            
+            //printf("Moving to point %d/%zu - Distance: %.1f\n", currentPathIndex, path.size(), distance);
+            
+            if (distance < 5.0f || insideCell) {
+                currentPathIndex++;
+                //printf("Reached point, moving to next (%d/%zu)\n", currentPathIndex, path.size());
+                continue;
+            }
+            
+            direction.x /= distance;
+            direction.y /= distance;
+            
+            float speed = agent.GetSpeed();
+            Vector2 newPosition = {
+                position.x + direction.x * speed * context.deltaTime * 60.0f,
+                position.y + direction.y * speed * context.deltaTime * 60.0f
+            };
+
+            agent.RequestMove(newPosition);
+            return;
+        }
+        
+        //printf("Reached final destination!\n");
+        agent.SetState(AgentState::Arrived);
+    }
+    
+    void FindPath(Agent& agent, Grid& grid, int minClearance) const {
+        
+        Vector2 position = agent.GetPosition();
+        Vector2 target = agent.Target();
+        
+        //printf("=== FINDING PATH ===\n");
+        //printf("World position: (%.1f, %.1f)\n", position.x, position.y);
+        //printf("Target: (%.1f, %.1f)\n", target.x, target.y);
+        
+        AStarPathfinder pathfinder;
+        Vector2 gridStart = {position.x / grid.GetCellSize(), position.y / grid.GetCellSize()};
+        
+        //printf("Grid coordinates - Start: (%.1f, %.1f), Target: (%.1f, %.1f)\n", gridStart.x, gridStart.y, target.x, target.y);
+        
+        // Verificar validade das posições
+        bool startValid = grid.IsValidPosition((int)gridStart.x, (int)gridStart.y);
+        bool targetValid = grid.IsValidPosition((int)target.x, (int)target.y);
+        bool startWalkable = startValid ? grid.IsWalkable((int)gridStart.x, (int)gridStart.y) : false;
+        bool targetWalkable = targetValid ? grid.IsWalkable((int)target.x, (int)target.y) : false;
+        
+        //printf("Start - valid: %s, walkable: %s\n", startValid ? "YES" : "NO", startWalkable ? "YES" : "NO");
+        //printf("Target - valid: %s, walkable: %s\n", targetValid ? "YES" : "NO", targetWalkable ? "YES" : "NO");
+        
+        std::vector<Vector2>& path = agent.Path();
+        
+        if (startValid && (int)gridStart.x == (int)target.x && (int)gridStart.y == (int)target.y) {
+            // Já está na célula do alvo: nada para buscar.
+            path.clear();
+            agent.SetState(AgentState::Arrived);
+        } else if (startValid && targetValid && startWalkable && targetWalkable) {
+            path = pathfinder.FindPath(grid, gridStart, target, "random", minClearance);
+            agent.SetState(path.empty() ? AgentState::Blocked : AgentState::Moving);
+            //printf("Pathfinding result: %s (%zu points)\n", has_path ? "SUCCESS" : "FAILED", path.size());
+        } else {
+            //printf("ERROR: Cannot find path - invalid positions\n");
+            path.clear();
+            agent.SetState(AgentState::Blocked);
+        }
+        
+        agent.PathIndex() = 0;
+        //printf("====================\n");
+    }
+};
+
+// Caminho "inteligente": por enquanto o mesmo A* da camada de baixo (espelha
+// SmartPathfindingDecorator); é o ponto para trocar a busca sem mexer no movimento.
+template <class Base>
+struct SmartPathfinding : Base {
+    void FindPath(Agent& agent, Grid& grid, int minClearance) const {
+        Base::FindPath(agent, grid, minClearance);
+    }
+};
+
+// Multiplica o passo de tempo visto pelas camadas de baixo (espelha SpeedBoostDecorator).
+// O fator é parte do tipo, como std::ratio; o padrão é o 2x dos agentes rápidos (tecla F).
+template <class Base, class Multiplier = std::ratio<2>>
+struct SpeedBoost : Base {
+    template <class Self>
+    void Update(Self& self, Agent& agent, const BehaviorContext& context) const {
+        const float multiplier = (float)Multiplier::num / (float)Multiplier::den;
+        Base::Update(self, agent, BehaviorContext{context.grid, context.deltaTime * multiplier, context.commands});
+    }
+};
+
+// Combinações usadas pelo programa. O índice da alternativa é o que AgentStorage guarda
+// em behaviorKind; acrescentar um tipo aqui basta para ele ganhar o seu laço.
+using StaticBehavior = std::variant<
+    BasicBehavior,
+    SmartPathfinding<BasicBehavior>,
+    SpeedBoost<BasicBehavior>,
+    SpeedBoost<SmartPathfinding<BasicBehavior>>>;
+
+static_assert(std::variant_size_v<StaticBehavior> < 255, "behaviorKind 255 é reservado para comportamentos dinâmicos");
+
+// Mesma escolha das teclas I (inteligente) e F (rápido) da interface.
+inline StaticBehavior MakeStaticBehavior(bool smart, bool fast) {
+    if (fast) {
+        if (smart) return SpeedBoost<SmartPathfinding<BasicBehavior>>{};
+        return SpeedBoost<BasicBehavior>{};
+    }
+    if (smart) return SmartPathfinding<BasicBehavior>{};
+    return BasicBehavior{};
+}
+
+namespace StaticBehaviorDetail {
+template <class Fn, std::size_t... Kinds>
+void Visit(uint8_t kind, Fn& fn, std::index_sequence<Kinds...>) {
+    ((kind == Kinds ? (fn(std::variant_alternative_t<Kinds, StaticBehavior>{}), true) : false) || ...);
+}
+}
+
+// Chama fn com uma instância do tipo concreto de `kind`. O switch é resolvido uma vez; um
+// fn que percorre vários agentes vira um laço próprio para cada tipo.
+template <class Fn>
+void VisitStaticBehavior(uint8_t kind, Fn&& fn) {
+    StaticBehaviorDetail::Visit(kind, fn, std::make_index_sequence<std::variant_size_v<StaticBehavior>>{});
+}
@@ -0,0 +1,65 @@
+#include "AgentManager.h"
+#include "Grid.h"
+#include "ThreadPool.h"
+#include "Random.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+// Mede a vazão de AgentManager::UpdateAll (agentes atualizados por segundo) variando o
+// número de threads do pool. Os primeiros quadros, que calculam os caminhos, ficam fora da medição.
+// Uso: AgentUpdateBenchmark [agentes] [orca 0|1]
+
+int main(int argc, char** argv) {
+    int agentCount = argc > 1 ? atoi(argv[1]) : 50000;
+    bool steering = argc > 2 && atoi(argv[2]) != 0;
+    const int warmupFrames = 3;
+    const int measuredFrames = 30;
+    int maxThreads = (int)std::max(1u, std::thread::hardware_concurrency());
+    
+    std::vector<int> threadCounts;
+    for (int t = 1; t < maxThreads; t *= 2) threadCounts.push_back(t);
+    threadCounts.push_back(maxThreads);
+    
+    std::ofstream csv("agent_update_benchmark.csv");
+    csv << "threads,agents,steering,frames,ms_per_frame,agents_per_second,speedup\n";
+    printf("Evitação local (ORCA): %s\n", steering ? "ligada" : "desligada");
+    printf("%-8s %-14s %-18s %-8s\n", "threads", "ms/quadro", "agentes/s", "speedup");
+    
+    double baseline = 0;
+    for (int threads : threadCounts) {
+        ThreadPool::DestroyInstance();
+        ThreadPool::CreateInstance(threads);
+        
+        Random::Seed(1234);
+        Grid grid(256, 256, 20.0f);
+        AgentManager agentManager(&grid);
+        agentManager.SetWorldSeed(1234);
+        agentManager.SetSteeringEnabled(steering);
+        agentManager.AddRandomAgents(agentCount);
+        
+        for (int frame = 0; frame < warmupFrames; frame++) {
+            agentManager.UpdateAll(1.0f / 60.0f);
+        }
+        
+        auto begin = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < measuredFrames; frame++) {
+            agentManager.UpdateAll(1.0f / 60.0f);
+        }
+        auto end = std::chrono::steady_clock::now();
+        
+        double ms = std::chrono::duration<double, std::milli>(end - begin).count() / measuredFrames;
+        double perSecond = agentCount / (ms / 1000.0);
+        if (baseline == 0) baseline = ms;
+        
+        printf("%-8d %-14.3f %-18.0f %.2fx\n", threads, ms, perSecond, baseline / ms);
+        csv << threads << "," << agentCount << "," << (steering ? 1 : 0) << "," << measuredFrames << "," << ms << ","
+            << perSecond << "," << baseline / ms << "\n";
+    }
+    
+    ThreadPool::DestroyInstance();
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "AgentManager.h"
+#include "CommandProcessor.h"
+#include "CommandExecutor.h"
+#include "Random.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+// Vazão de comandos pelo CommandProcessor, como no passo da simulação: cada quadro todos
+// os agentes emitem um MoveAgent em buffers por bloco, que são juntados na agenda e
+// executados. Conta também as alocações de memória nos quadros medidos, que devem ser
+// zero depois do aquecimento. O histórico de desfazer fica ligado: é um anel limitado e
+// os movimentos de cada agente se juntam num registro, então também não aloca.
+
+namespace {
+std::atomic<long long> allocationCount{0};
+}
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size ? size : 1)) return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+
+int main(int argc, char** argv) {
+    const int agentCount = argc > 1 ? atoi(argv[1]) : 100000;
+    const int warmupFrames = 5;
+    const int measuredFrames = 60;
+    const double frameDelta = 1.0 / 60.0;
+
+    Random::Seed(1234);
+    Grid grid(512, 512, 20.0f);
+    AgentManager agentManager(&grid);
+    agentManager.SpawnAgents(agentCount);
+    AgentStorage& agents = agentManager.GetStorage();
+
+    CommandProcessor processor;
+    CommandExecutor executor(agents, grid);
+    std::vector<CommandBuffer> buffers(ThreadPool::ChunkCount(agents.Size(), AgentManager::UPDATE_CHUNK));
+
+    double time = 0.0;
+    auto runFrame = [&]() {
+        time += frameDelta;
+        for (int chunk = 0; chunk < (int)buffers.size(); chunk++) {
+            int begin = chunk * AgentManager::UPDATE_CHUNK;
+            int end = std::min(agents.Size(), begin + AgentManager::UPDATE_CHUNK);
+            for (int i = begin; i < end; i++) {
+                Vector2 from = {agents.positionX[i], agents.positionY[i]};
+                Vector2 to = {from.x + ((i + (int)(time * 60)) % 3 - 1) * 0.5f, from.y};
+                buffers[chunk].AddCommand(Command::Move(agents.handle[i], from, to, time));
+            }
+        }
+        for (CommandBuffer& buffer : buffers) {
+            processor.AddCommands(buffer);
+        }
+        processor.ProcessCommands(time, executor);
+    };
+
+    for (int frame = 0; frame < warmupFrames; frame++) {
+        runFrame();
+    }
+
+    long long allocationsBefore = allocationCount.load();
+    auto begin = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < measuredFrames; frame++) {
+        runFrame();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    long long allocations = allocationCount.load() - allocationsBefore;
+
+    double commands = (double)agents.Size() * measuredFrames;
+    double commandsPerSecond = commands / seconds;
+    printf("Comando: %zu bytes | %d agentes | %d quadros | %d threads\n", sizeof(Command), agents.Size(), measuredFrames,
+           ThreadPool::GetInstance().GetThreadCount());
+    printf("%.3f ms/quadro | %.0f comandos/s | %lld alocações nos quadros medidos\n",
+           seconds * 1000.0 / measuredFrames, commandsPerSecond, allocations);
+    printf("Histórico: %d de %d registros\n", processor.GetHistorySize(), processor.GetHistoryDepth());
+
+    std::ofstream csv("command_benchmark.csv");
+    csv << "agents,frames,command_bytes,ms_per_frame,commands_per_second,allocations\n";
+    csv << agents.Size() << "," << measuredFrames << "," << sizeof(Command) << "," << seconds * 1000.0 / measuredFrames
+        << "," << commandsPerSecond << "," << allocations << "\n";
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include "Grid.h"
+#include "NoiseObstacleFactory.h"
+#include "MazeObstacleFactory.h"
+#include "RoomsObstacleFactory.h"
+#include "CityBlockObstacleFactory.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Mede o tempo de geração de mapas grandes e confere que a mesma seed gera
+// exatamente o mesmo mapa com 1 thread e com todos os núcleos.
+
+struct Generator {
+    std::string name;
+    std::unique_ptr<ProceduralObstacleFactory> singleThread;
+    std::unique_ptr<ProceduralObstacleFactory> allThreads;
+};
+
+static int ParallelThreads() {
+    return (int)std::max(4u, std::thread::hardware_concurrency());
+}
+
+template <typename FactoryT, typename... Args>
+static Generator MakeGenerator(const std::string& name, Args... args) {
+    return {name, std::make_unique<FactoryT>(args..., 1), std::make_unique<FactoryT>(args..., ParallelThreads())};
+}
+
+int main() {
+    const uint64_t seed = 42;
+    std::vector<int> sizes = {256, 1024, 2048};
+    
+    std::vector<Generator> generators;
+    generators.push_back(MakeGenerator<NoiseObstacleFactory>("noise", seed, 12.0f, 0.6f, 3));
+    generators.push_back(MakeGenerator<MazeObstacleFactory>("maze", seed));
+    generators.push_back(MakeGenerator<RoomsObstacleFactory>("rooms", seed, 16));
+    generators.push_back(MakeGenerator<CityBlockObstacleFactory>("city", seed, 10, 2));
+    
+    std::ofstream csv("map_generation_benchmark.csv");
+    csv << "generator,size,threads,mask_ms,apply_ms,blocked_ratio\n";
+    printf("threads: %d\n", ParallelThreads());
+    printf("%-8s %-10s %-12s %-12s %-10s %-8s\n", "gen", "size", "1 thread ms", "N threads ms", "apply ms", "blocked");
+    
+    for (auto& generator : generators) {
+        for (int size : sizes) {
+            auto t0 = std::chrono::steady_clock::now();
+            auto serialMask = generator.singleThread->GenerateMask(size, size);
+            auto t1 = std::chrono::steady_clock::now();
+            auto parallelMask = generator.allThreads->GenerateMask(size, size);
+            auto t2 = std::chrono::steady_clock::now();
+            
+            if (serialMask != parallelMask) {
+                printf("ERRO: %s %dx%d difere entre 1 e N threads\n", generator.name.c_str(), size, size);
+                return 1;
+            }
+            
+            Grid grid(size, size, 1.0f);
+            auto t3 = std::chrono::steady_clock::now();
+            grid.ApplyObstacleMask(parallelMask);
+            auto t4 = std::chrono::steady_clock::now();
+            
+            long blocked = 0;
+            for (uint8_t b : parallelMask) blocked += b;
+            double ratio = (double)blocked / parallelMask.size();
+            
+            double serialMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+            double parallelMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+            double applyMs = std::chrono::duration<double, std::milli>(t4 - t3).count();
+            
+            printf("%-8s %4dx%-5d %-12.2f %-12.2f %-10.2f %.2f\n", generator.name.c_str(), size, size,
+                   serialMs, parallelMs, applyMs, ratio);
+            csv << generator.name << "," << size << ",1," << serialMs << "," << applyMs << "," << ratio << "\n";
+            csv << generator.name << "," << size << ",N," << parallelMs << "," << applyMs << "," << ratio << "\n";
+        }
+    }
+    return 0;
+}
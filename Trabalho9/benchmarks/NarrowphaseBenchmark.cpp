@@ -0,0 +1,95 @@
+#include "CollisionKernels.h"
+#include "CounterRng.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+// Microbenchmark da narrowphase: um agente contra blocos de vizinhos do tamanho típico de
+// uma vizinhança da grade uniforme, para cada kernel disponível. Confere que todos os
+// kernels produzem exatamente os mesmos acertos e mede pares testados por segundo.
+
+struct KernelEntry {
+    const char* name;
+    CollisionKernels::Kernel kernel;
+    bool supported;
+};
+
+int main(int argc, char** argv) {
+    const int neighborCount = 1 << 16;
+    const int blockSize = argc > 1 ? atoi(argv[1]) : 32;
+    const int repetitions = 200;
+
+    CounterRng rng(42, 0);
+    std::vector<float> x(neighborCount), y(neighborCount), broad(neighborCount), coll(neighborCount);
+    for (int i = 0; i < neighborCount; i++) {
+        x[i] = rng.UniformAt(i, 0) * 100.0f;
+        y[i] = rng.UniformAt(i, 1) * 100.0f;
+        broad[i] = 10.0f + rng.UniformAt(i, 2) * 10.0f;
+        coll[i] = 4.0f + rng.UniformAt(i, 3) * 6.0f;
+    }
+
+    KernelEntry kernels[] = {
+        {"Scalar", CollisionKernels::Scalar, true},
+        {"SSE", CollisionKernels::SSE, CollisionKernels::HasSSE()},
+        {"AVX2", CollisionKernels::AVX2, CollisionKernels::HasAVX2()},
+    };
+
+    std::vector<int> referenceIndex, referenceCollides;
+    std::vector<int> hitIndex(blockSize + CollisionKernels::PADDING);
+    std::vector<int> hitCollides(blockSize + CollisionKernels::PADDING);
+
+    std::ofstream csv("narrowphase_benchmark.csv");
+    csv << "kernel,block_size,pairs,ms,pairs_per_second,speedup,matches_scalar\n";
+    printf("Kernel selecionado: %s | bloco: %d vizinhos\n", CollisionKernels::SelectedName(), blockSize);
+    printf("%-8s %-12s %-20s %-8s %s\n", "kernel", "ms", "pares/s", "speedup", "confere");
+
+    double scalarMs = 0;
+    for (const KernelEntry& entry : kernels) {
+        if (!entry.supported) {
+            printf("%-8s não suportado nesta CPU\n", entry.name);
+            continue;
+        }
+
+        // Conferência: todos os acertos, em ordem, iguais aos do kernel escalar.
+        std::vector<int> allIndex, allCollides;
+        for (int begin = 0; begin + blockSize <= neighborCount; begin += blockSize) {
+            int agent = (begin + blockSize) % neighborCount;
+            int hits = entry.kernel(x[agent], y[agent], broad[agent], coll[agent],
+                                    x.data() + begin, y.data() + begin, broad.data() + begin, coll.data() + begin,
+                                    blockSize, hitIndex.data(), hitCollides.data());
+            allIndex.insert(allIndex.end(), hitIndex.begin(), hitIndex.begin() + hits);
+            allCollides.insert(allCollides.end(), hitCollides.begin(), hitCollides.begin() + hits);
+        }
+        if (referenceIndex.empty()) {
+            referenceIndex = allIndex;
+            referenceCollides = allCollides;
+        }
+        bool matches = allIndex == referenceIndex && allCollides == referenceCollides;
+
+        long long totalHits = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repetitions; r++) {
+            for (int begin = 0; begin + blockSize <= neighborCount; begin += blockSize) {
+                int agent = (begin + r) % neighborCount;
+                totalHits += entry.kernel(x[agent], y[agent], broad[agent], coll[agent],
+                                          x.data() + begin, y.data() + begin, broad.data() + begin, coll.data() + begin,
+                                          blockSize, hitIndex.data(), hitCollides.data());
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        double pairs = (double)repetitions * (neighborCount / blockSize) * blockSize;
+        double pairsPerSecond = pairs / (ms / 1000.0);
+        if (scalarMs == 0) scalarMs = ms;
+
+        printf("%-8s %-12.3f %-20.0f %-8.2f %s (%lld acertos)\n", entry.name, ms, pairsPerSecond, scalarMs / ms,
+               matches ? "sim" : "NAO", totalHits);
+        csv << entry.name << "," << blockSize << "," << (long long)pairs << "," << ms << ","
+            << pairsPerSecond << "," << scalarMs / ms << "," << (matches ? 1 : 0) << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "Grid.h"
+#include "AStarPathfinder.h"
+#include "DialPathfinder.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <vector>
+
+// Compara o A* com heap binário e o A* com baldes (Dial) nos mesmos mapas com custo
+// de terreno. Cada mapa tem ~20% de obstáculos e manchas de terreno com custo 2..maxCost.
+
+struct Query {
+    Vector2 start;
+    Vector2 end;
+};
+
+static int PathCost(Grid& grid, const std::vector<Vector2>& path) {
+    int cost = 0;
+    for (size_t i = 1; i < path.size(); i++) {
+        cost += grid.GetTerrainCost((int)path[i].x, (int)path[i].y);
+    }
+    return cost;
+}
+
+static void BuildWeightedMap(Grid& grid, std::mt19937& rng, int maxCost) {
+    int width = grid.GetWidth();
+    int height = grid.GetHeight();
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::uniform_int_distribution<int> cost(2, maxCost);
+    std::uniform_int_distribution<int> radius(1, 6);
+    std::uniform_int_distribution<int> px(0, width - 1);
+    std::uniform_int_distribution<int> py(0, height - 1);
+    
+    for (int i = 0; i < (width * height) / 60; i++) {
+        int cx = px(rng), cy = py(rng), r = radius(rng);
+        uint8_t c = (uint8_t)cost(rng);
+        for (int y = cy - r; y <= cy + r; y++) {
+            for (int x = cx - r; x <= cx + r; x++) {
+                grid.SetTerrainCost(x, y, c);
+            }
+        }
+    }
+    
+    grid.BeginBatchEdit();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (percent(rng) < 20) grid.SetWalkable(x, y, false);
+        }
+    }
+    grid.EndBatchEdit();
+}
+
+template <typename PathfinderT>
+static double TimeQueries(Grid& grid, const std::vector<Query>& queries, std::vector<int>& costs) {
+    PathfinderT pathfinder;
+    costs.clear();
+    auto begin = std::chrono::steady_clock::now();
+    for (const auto& q : queries) {
+        auto path = pathfinder.FindPath(grid, q.start, q.end);
+        costs.push_back(path.empty() ? -1 : PathCost(grid, path));
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+int main() {
+    std::vector<std::pair<int, int>> gridSizes = {{64, 64}, {256, 256}, {512, 512}, {1024, 1024}};
+    std::vector<int> maxCosts = {9, 255};
+    const int queryCount = 200;
+    
+    std::ofstream csv("pathfinding_benchmark.csv");
+    csv << "grid_width,grid_height,max_cost,queries,astar_heap_ms,dial_ms,speedup\n";
+    printf("%-11s %-8s %-14s %-10s %-8s\n", "grid", "maxCost", "A* heap (ms)", "Dial (ms)", "speedup");
+    
+    for (auto& size : gridSizes) {
+        for (int maxCost : maxCosts) {
+            std::mt19937 rng(1234);
+            Grid grid(size.first, size.second, 10.0f);
+            BuildWeightedMap(grid, rng, maxCost);
+            
+            std::vector<Query> queries;
+            std::uniform_int_distribution<int> px(0, size.first - 1);
+            std::uniform_int_distribution<int> py(0, size.second - 1);
+            while ((int)queries.size() < queryCount) {
+                Query q = {{(float)px(rng), (float)py(rng)}, {(float)px(rng), (float)py(rng)}};
+                if (grid.IsWalkable((int)q.start.x, (int)q.start.y) && grid.IsWalkable((int)q.end.x, (int)q.end.y)) {
+                    queries.push_back(q);
+                }
+            }
+            
+            std::vector<int> heapCosts, dialCosts;
+            double heapMs = TimeQueries<AStarPathfinder>(grid, queries, heapCosts);
+            double dialMs = TimeQueries<DialPathfinder>(grid, queries, dialCosts);
+            
+            if (heapCosts != dialCosts) {
+                printf("ERRO: custos diferentes entre A* e Dial em %dx%d\n", size.first, size.second);
+                return 1;
+            }
+            
+            printf("%4dx%-6d %-8d %-14.2f %-10.2f %.2fx\n", size.first, size.second, maxCost,
+                   heapMs, dialMs, heapMs / dialMs);
+            csv << size.first << "," << size.second << "," << maxCost << "," << queryCount << ","
+                << heapMs << "," << dialMs << "," << heapMs / dialMs << "\n";
+        }
+    }
+    return 0;
+}
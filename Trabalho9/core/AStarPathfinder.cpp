@@ -1,101 +1,93 @@
+#include "Clock.h"
+#include "Metrics.h"
 #include "AStarPathfinder.h"
 
-double AStarPathfinder::lastExecutionTime = 0.0;
+thread_local double AStarPathfinder::lastExecutionTime = 0.0;
 
-float AStarPathfinder::CalculateHeuristic(int x1, int y1, int x2, int y2) {
-    return abs(x1 - x2) + abs(y1 - y2);
+namespace {
+thread_local SearchScratch scratch;
 }
 
-std::vector<Node*> AStarPathfinder::GetNeighbors(Node* node, Grid& grid) {
-    std::vector<Node*> neighbors;
-    int directions[4][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
-    
-    for (auto& dir : directions) {
-        int newX = node->x + dir[0];
-        int newY = node->y + dir[1];
-        
-        if (grid.IsWalkable(newX, newY)) {
-            Node* neighbor = grid.GetNode(newX, newY);
-            if (neighbor) {
-                neighbors.push_back(neighbor);
-            }
-        }
-    }
-    return neighbors;
+int AStarPathfinder::CalculateHeuristic(int x1, int y1, int x2, int y2) {
+    return abs(x1 - x2) + abs(y1 - y2);
 }
 
-std::vector<Vector2> AStarPathfinder::ReconstructPath(Node* endNode) {
+std::vector<Vector2> AStarPathfinder::ReconstructPath(const SearchScratch& scratch, int endIndex, int width) {
     std::vector<Vector2> path;
-    Node* currentNode = endNode;
     
-    while (currentNode != nullptr) {
-        path.push_back({(float)currentNode->x, (float)currentNode->y});
-        currentNode = currentNode->parent;
+    for (int i = endIndex; i != -1; i = scratch.parent[i]) {
+        path.push_back({(float)(i % width), (float)(i / width)});
     }
     
     std::reverse(path.begin(), path.end());
     return path;
 }
 
-std::vector<Vector2> AStarPathfinder::FindPath(Grid& grid, Vector2 start, Vector2 end, const std::string& distribution) {
-    double startTime = GetTime();
-    
-    grid.ResetPathfindingData();
+// A* com heap binário e custo de terreno por célula. O custo de um passo é o custo da
+// célula de destino (Grid::GetTerrainCost, mínimo 1), então a distância de Manhattan
+// continua admissível. Entradas obsoletas do heap são descartadas ao sair (lazy deletion).
+std::vector<Vector2> AStarPathfinder::FindPath(Grid& grid, Vector2 start, Vector2 end, const std::string& distribution,
+                                               int minClearance) {
+    double startTime = Clock::Now();
     
-    Node* startNode = grid.GetNode((int)start.x, (int)start.y);
-    Node* endNode = grid.GetNode((int)end.x, (int)end.y);
+    int width = grid.GetWidth();
+    int sx = (int)start.x, sy = (int)start.y;
+    int ex = (int)end.x, ey = (int)end.y;
     
-    if (!startNode || !endNode || !startNode->walkable || !endNode->walkable) {
+    if (!grid.IsWalkable(sx, sy) || !grid.IsWalkable(ex, ey)) {
         return {};
     }
     
-    std::vector<Node*> openSet;
-    std::vector<Node*> closedSet;
+    scratch.Prepare(width * grid.GetHeight());
+    int startIndex = sy * width + sx;
+    int endIndex = ey * width + ex;
     
-    openSet.push_back(startNode);
+    std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<OpenEntry>> openSet;
+    int h = CalculateHeuristic(sx, sy, ex, ey);
+    scratch.Visit(startIndex, 0, -1);
+    openSet.push({h, h, startIndex});
+    
+    const int directions[4][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
     
     while (!openSet.empty()) {
-        Node* currentNode = openSet[0];
-        int currentIndex = 0;
-        
-        for (int i = 1; i < openSet.size(); i++) {
-            if (openSet[i]->fCost() < currentNode->fCost() || 
-                (openSet[i]->fCost() == currentNode->fCost() && openSet[i]->hCost < currentNode->hCost)) {
-                currentNode = openSet[i];
-                currentIndex = i;
-            }
-        }
+        OpenEntry current = openSet.top();
+        openSet.pop();
         
-        openSet.erase(openSet.begin() + currentIndex);
-        closedSet.push_back(currentNode);
+        if (scratch.IsClosed(current.index)) continue;
+        scratch.Close(current.index);
         
-        if (currentNode == endNode) {
-            lastExecutionTime = GetTime() - startTime;
-            return ReconstructPath(currentNode);
+        if (current.index == endIndex) {
+            lastExecutionTime = Clock::Now() - startTime;
+            std::vector<Vector2> path = ReconstructPath(scratch, endIndex, width);
+            Metrics::RecordPathfinding(Metrics::GetAgentCount(), width, grid.GetHeight(), lastExecutionTime,
+                                       (int)path.size(), distribution);
+            return path;
         }
         
-        auto neighbors = GetNeighbors(currentNode, grid);
-        for (auto neighbor : neighbors) {
-            if (std::find(closedSet.begin(), closedSet.end(), neighbor) != closedSet.end()) {
-                continue;
-            }
+        int cx = current.index % width;
+        int cy = current.index / width;
+        int currentG = scratch.gCost[current.index];
+        
+        for (auto& dir : directions) {
+            int nx = cx + dir[0];
+            int ny = cy + dir[1];
             
-            float newGCost = currentNode->gCost + 1;
+            if (!grid.IsWalkable(nx, ny)) continue;
             
-            if (newGCost < neighbor->gCost || 
-                std::find(openSet.begin(), openSet.end(), neighbor) == openSet.end()) {
-                
-                neighbor->gCost = newGCost;
-                neighbor->hCost = CalculateHeuristic(neighbor->x, neighbor->y, endNode->x, endNode->y);
-                neighbor->parent = currentNode;
-                
-                if (std::find(openSet.begin(), openSet.end(), neighbor) == openSet.end()) {
-                    openSet.push_back(neighbor);
-                }
+            int neighbor = ny * width + nx;
+            if (neighbor != endIndex && grid.GetClearance(nx, ny) < minClearance) continue;
+            if (scratch.IsClosed(neighbor)) continue;
+            
+            int newGCost = currentG + grid.GetTerrainCost(nx, ny);
+            if (!scratch.IsVisited(neighbor) || newGCost < scratch.gCost[neighbor]) {
+                scratch.Visit(neighbor, newGCost, current.index);
+                int nh = CalculateHeuristic(nx, ny, ex, ey);
+                openSet.push({newGCost + nh, nh, neighbor});
             }
         }
     }
     
-    lastExecutionTime = GetTime() - startTime;
+    lastExecutionTime = Clock::Now() - startTime;
+    Metrics::RecordPathfinding(Metrics::GetAgentCount(), width, grid.GetHeight(), lastExecutionTime, 0, distribution);
     return {};
-}
\ No newline at end of file
+}
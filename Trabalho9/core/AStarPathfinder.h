@@ -1,6 +1,7 @@
 #pragma once
 #include "Pathfinder.h"
 #include "Grid.h"
+#include "SearchScratch.h"
 #include <vector>
 #include <algorithm>
 #include <cmath>
@@ -9,14 +10,24 @@
 
 class AStarPathfinder : public Pathfinder {
 private:
-    static double lastExecutionTime;
+    static thread_local double lastExecutionTime;
     
-    float CalculateHeuristic(int x1, int y1, int x2, int y2);
-    std::vector<Node*> GetNeighbors(Node* node, Grid& grid);
-    std::vector<Vector2> ReconstructPath(Node* endNode);
+    struct OpenEntry {
+        int fCost;
+        int hCost;
+        int index;
+        
+        bool operator>(const OpenEntry& other) const {
+            return fCost > other.fCost || (fCost == other.fCost && hCost > other.hCost);
+        }
+    };
     
 public:
+    static int CalculateHeuristic(int x1, int y1, int x2, int y2);
+    static std::vector<Vector2> ReconstructPath(const SearchScratch& scratch, int endIndex, int width);
+    
     std::vector<Vector2> FindPath(Grid& grid, Vector2 start, Vector2 end, 
-                                 const std::string& distribution = "random") override;
+                                 const std::string& distribution = "random",
+                                 int minClearance = 0) override;
     double GetLastExecutionTime() override { return lastExecutionTime; }
-};
\ No newline at end of file
+};
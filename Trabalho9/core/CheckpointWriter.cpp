@@ -0,0 +1,87 @@
+#include "CheckpointWriter.h"
+#include "SimulationSnapshot.h"
+#include <cstdio>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+namespace {
+
+// Troca `path` pelo arquivo temporário. No Windows std::rename falha se `path` já existe.
+bool ReplaceWith(const std::string& temporary, const std::string& path) {
+#ifdef _WIN32
+    return MoveFileExA(temporary.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+#endif
+}
+
+}
+
+CheckpointWriter::CheckpointWriter() {
+    worker = std::thread(&CheckpointWriter::WorkerLoop, this);
+}
+
+CheckpointWriter::~CheckpointWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+void CheckpointWriter::Submit(std::vector<uint8_t>& snapshot, const std::string& path) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.swap(snapshot);
+        pendingPath = path;
+        hasPending = true;
+    }
+    wake.notify_one();
+}
+
+void CheckpointWriter::Flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return !hasPending && !writing; });
+}
+
+uint64_t CheckpointWriter::GetWrittenCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return writtenCount;
+}
+
+uint64_t CheckpointWriter::GetFailedCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return failedCount;
+}
+
+void CheckpointWriter::WorkerLoop() {
+    std::vector<uint8_t> data;
+    std::string path;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this] { return hasPending || stopping; });
+        if (!hasPending) break;
+        
+        data.swap(pending);
+        path.swap(pendingPath);
+        hasPending = false;
+        writing = true;
+        lock.unlock();
+        
+        std::string temporary = path + ".tmp";
+        bool ok = WriteSnapshotFile(temporary, data) && ReplaceWith(temporary, path);
+        
+        lock.lock();
+        writing = false;
+        if (ok) {
+            writtenCount++;
+        } else {
+            failedCount++;
+        }
+        idle.notify_all();
+    }
+}
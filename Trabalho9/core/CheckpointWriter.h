@@ -0,0 +1,48 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Grava snapshots em disco numa thread própria, para que a simulação não espere pelo I/O.
+// Usa dois buffers: Submit troca o buffer recém-capturado pelo pendente (sem cópia) e o
+// chamador recebe de volta um buffer já alocado para a próxima captura. Se um checkpoint
+// chegar antes de o anterior ser gravado, o anterior é descartado: só o mais recente
+// importa. Cada arquivo é escrito num temporário e renomeado, então um arquivo de
+// checkpoint nunca fica pela metade.
+class CheckpointWriter {
+private:
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    
+    std::vector<uint8_t> pending;
+    std::string pendingPath;
+    bool hasPending = false;
+    bool writing = false;
+    bool stopping = false;
+    
+    uint64_t writtenCount = 0;
+    uint64_t failedCount = 0;
+    
+    void WorkerLoop();
+    
+public:
+    CheckpointWriter();
+    // Grava o que estiver pendente antes de encerrar a thread.
+    ~CheckpointWriter();
+    
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+    
+    // `snapshot` é trocado pelo buffer livre (conteúdo indefinido, capacidade mantida).
+    void Submit(std::vector<uint8_t>& snapshot, const std::string& path);
+    // Bloqueia até não haver nada pendente nem sendo gravado.
+    void Flush();
+    
+    uint64_t GetWrittenCount();
+    uint64_t GetFailedCount();
+};
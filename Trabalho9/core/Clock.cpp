@@ -0,0 +1,17 @@
+#include "Clock.h"
+#include <chrono>
+
+namespace {
+SteadyClock defaultClock;
+}
+
+IClock* Clock::source = &defaultClock;
+
+double SteadyClock::Now() const {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+void Clock::SetSource(IClock* clock) {
+    source = clock ? clock : &defaultClock;
+}
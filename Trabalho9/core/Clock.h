@@ -0,0 +1,27 @@
+#pragma once
+
+class IClock {
+public:
+    virtual ~IClock() = default;
+    // Segundos desde um ponto de referência fixo.
+    virtual double Now() const = 0;
+};
+
+// Relógio monotônico (std::chrono::steady_clock); é a fonte padrão de Clock.
+class SteadyClock : public IClock {
+public:
+    double Now() const override;
+};
+
+// Relógio usado pela navcore para medir tempos (pathfinding, métricas). Pode ser trocado,
+// por exemplo, por um relógio falso em testes ou pelo GetTime do raylib no front end.
+class Clock {
+private:
+    static IClock* source;
+    
+public:
+    static double Now() { return source->Now(); }
+    // nullptr volta para o SteadyClock padrão. O relógio passado precisa viver enquanto
+    // estiver instalado.
+    static void SetSource(IClock* clock);
+};
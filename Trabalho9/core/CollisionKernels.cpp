@@ -0,0 +1,212 @@
+#include "CollisionKernels.h"
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define NAV_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define NAV_TARGET_SSE __attribute__((target("sse2")))
+#define NAV_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define NAV_TARGET_SSE
+#define NAV_TARGET_AVX2
+#endif
+
+namespace {
+
+// Todas as versões calculam dx*dx + dy*dy com multiplicação e soma separadas (sem FMA),
+// para que o resultado seja idêntico ao escalar em qualquer caminho.
+inline int ScalarRange(float x, float y, float broad, float coll,
+                       const float* neighborX, const float* neighborY,
+                       const float* neighborBroad, const float* neighborColl,
+                       int begin, int end, int* hitIndex, int* hitCollides, int hits) {
+    for (int i = begin; i < end; i++) {
+        const float dx = x - neighborX[i];
+        const float dy = y - neighborY[i];
+        const float distSq = dx * dx + dy * dy;
+        const float broadSum = broad + neighborBroad[i];
+        if (distSq > broadSum * broadSum) continue;
+
+        const float collSum = coll + neighborColl[i];
+        hitIndex[hits] = i;
+        hitCollides[hits] = distSq <= collSum * collSum;
+        hits++;
+    }
+    return hits;
+}
+
+#ifdef NAV_X86
+
+// Para cada máscara de 8 bits, a permutação que leva as lanes ativas para o início do
+// vetor, e quantas são. Emula o "compress store" que o AVX2 não tem.
+struct CompressTable {
+    alignas(32) int32_t permutation[256][8];
+    uint8_t popCount[256];
+
+    CompressTable() {
+        for (int mask = 0; mask < 256; mask++) {
+            int n = 0;
+            for (int lane = 0; lane < 8; lane++) {
+                if (mask & (1 << lane)) permutation[mask][n++] = lane;
+            }
+            popCount[mask] = (uint8_t)n;
+            for (int lane = n; lane < 8; lane++) permutation[mask][lane] = 0;
+        }
+    }
+};
+
+const CompressTable compressTable;
+
+#endif
+
+}
+
+int CollisionKernels::Scalar(float x, float y, float broad, float coll,
+                             const float* neighborX, const float* neighborY,
+                             const float* neighborBroad, const float* neighborColl,
+                             int count, int* hitIndex, int* hitCollides) {
+    return ScalarRange(x, y, broad, coll, neighborX, neighborY, neighborBroad, neighborColl,
+                       0, count, hitIndex, hitCollides, 0);
+}
+
+#ifdef NAV_X86
+
+NAV_TARGET_SSE
+int CollisionKernels::SSE(float x, float y, float broad, float coll,
+                          const float* neighborX, const float* neighborY,
+                          const float* neighborBroad, const float* neighborColl,
+                          int count, int* hitIndex, int* hitCollides) {
+    const __m128 vx = _mm_set1_ps(x);
+    const __m128 vy = _mm_set1_ps(y);
+    const __m128 vBroad = _mm_set1_ps(broad);
+    const __m128 vColl = _mm_set1_ps(coll);
+
+    int hits = 0;
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 dx = _mm_sub_ps(vx, _mm_loadu_ps(neighborX + i));
+        const __m128 dy = _mm_sub_ps(vy, _mm_loadu_ps(neighborY + i));
+        const __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        const __m128 broadSum = _mm_add_ps(vBroad, _mm_loadu_ps(neighborBroad + i));
+        const __m128 collSum = _mm_add_ps(vColl, _mm_loadu_ps(neighborColl + i));
+
+        const int broadMask = _mm_movemask_ps(_mm_cmple_ps(distSq, _mm_mul_ps(broadSum, broadSum)));
+        if (!broadMask) continue;
+        const int collMask = _mm_movemask_ps(_mm_cmple_ps(distSq, _mm_mul_ps(collSum, collSum)));
+
+        for (int lane = 0; lane < 4; lane++) {
+            if (!(broadMask & (1 << lane))) continue;
+            hitIndex[hits] = i + lane;
+            hitCollides[hits] = (collMask >> lane) & 1;
+            hits++;
+        }
+    }
+
+    return ScalarRange(x, y, broad, coll, neighborX, neighborY, neighborBroad, neighborColl,
+                       i, count, hitIndex, hitCollides, hits);
+}
+
+// Um agente contra 8 vizinhos por iteração. As lanes que passam no teste amplo são
+// compactadas com uma permutação da tabela e gravadas de uma vez (8 lanes, das quais
+// só as primeiras `popCount` valem; o resto é sobrescrito na próxima iteração).
+NAV_TARGET_AVX2
+int CollisionKernels::AVX2(float x, float y, float broad, float coll,
+                           const float* neighborX, const float* neighborY,
+                           const float* neighborBroad, const float* neighborColl,
+                           int count, int* hitIndex, int* hitCollides) {
+    const __m256 vx = _mm256_set1_ps(x);
+    const __m256 vy = _mm256_set1_ps(y);
+    const __m256 vBroad = _mm256_set1_ps(broad);
+    const __m256 vColl = _mm256_set1_ps(coll);
+    const __m256i laneIndex = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i one = _mm256_set1_epi32(1);
+
+    int hits = 0;
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 dx = _mm256_sub_ps(vx, _mm256_loadu_ps(neighborX + i));
+        const __m256 dy = _mm256_sub_ps(vy, _mm256_loadu_ps(neighborY + i));
+        const __m256 distSq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        const __m256 broadSum = _mm256_add_ps(vBroad, _mm256_loadu_ps(neighborBroad + i));
+        const __m256 collSum = _mm256_add_ps(vColl, _mm256_loadu_ps(neighborColl + i));
+
+        const __m256 broadHit = _mm256_cmp_ps(distSq, _mm256_mul_ps(broadSum, broadSum), _CMP_LE_OQ);
+        const int broadMask = _mm256_movemask_ps(broadHit);
+        if (!broadMask) continue;
+        const __m256 collHit = _mm256_cmp_ps(distSq, _mm256_mul_ps(collSum, collSum), _CMP_LE_OQ);
+
+        const __m256i permutation = _mm256_load_si256((const __m256i*)compressTable.permutation[broadMask]);
+        const __m256i indices = _mm256_add_epi32(laneIndex, _mm256_set1_epi32(i));
+        const __m256i collides = _mm256_and_si256(_mm256_castps_si256(collHit), one);
+
+        _mm256_storeu_si256((__m256i*)(hitIndex + hits), _mm256_permutevar8x32_epi32(indices, permutation));
+        _mm256_storeu_si256((__m256i*)(hitCollides + hits), _mm256_permutevar8x32_epi32(collides, permutation));
+        hits += compressTable.popCount[broadMask];
+    }
+
+    return ScalarRange(x, y, broad, coll, neighborX, neighborY, neighborBroad, neighborColl,
+                       i, count, hitIndex, hitCollides, hits);
+}
+
+bool CollisionKernels::HasSSE() {
+#if defined(__x86_64__) || defined(_M_X64)
+    return true;
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_cpu_supports("sse2");
+#else
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#endif
+}
+
+bool CollisionKernels::HasAVX2() {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_cpu_supports("avx2");
+#else
+    int info[4];
+    __cpuid(info, 1);
+    bool osSavesYmm = (info[2] & (1 << 27)) && (_xgetbv(0) & 0x6) == 0x6;
+    if (!osSavesYmm) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#endif
+}
+
+#else
+
+int CollisionKernels::SSE(float x, float y, float broad, float coll,
+                          const float* neighborX, const float* neighborY,
+                          const float* neighborBroad, const float* neighborColl,
+                          int count, int* hitIndex, int* hitCollides) {
+    return Scalar(x, y, broad, coll, neighborX, neighborY, neighborBroad, neighborColl, count, hitIndex, hitCollides);
+}
+
+int CollisionKernels::AVX2(float x, float y, float broad, float coll,
+                           const float* neighborX, const float* neighborY,
+                           const float* neighborBroad, const float* neighborColl,
+                           int count, int* hitIndex, int* hitCollides) {
+    return Scalar(x, y, broad, coll, neighborX, neighborY, neighborBroad, neighborColl, count, hitIndex, hitCollides);
+}
+
+bool CollisionKernels::HasSSE() { return false; }
+bool CollisionKernels::HasAVX2() { return false; }
+
+#endif
+
+CollisionKernels::Kernel CollisionKernels::Select() {
+    static const Kernel selected = HasAVX2() ? AVX2 : HasSSE() ? SSE : Scalar;
+    return selected;
+}
+
+const char* CollisionKernels::SelectedName() {
+    Kernel kernel = Select();
+    if (kernel == AVX2) return "AVX2";
+    if (kernel == SSE) return "SSE";
+    return "Scalar";
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+// Narrowphase círculo-círculo: testa um agente contra um bloco contíguo de vizinhos em
+// arrays SoA, para os dois limiares (raio amplo e raio de colisão) de uma vez.
+//
+// Os acertos do raio amplo são gravados compactados: hitIndex recebe o deslocamento
+// (0..count-1) de cada vizinho atingido e hitCollides, no mesmo índice, 1 se ele também
+// colide pelo raio de colisão. Retorna o número de acertos. As versões vetoriais
+// escrevem até 8 posições além do último acerto, então os buffers precisam de
+// count + PADDING entradas.
+class CollisionKernels {
+public:
+    using Kernel = int (*)(float x, float y, float broad, float coll,
+                           const float* neighborX, const float* neighborY,
+                           const float* neighborBroad, const float* neighborColl,
+                           int count, int* hitIndex, int* hitCollides);
+
+    static constexpr int PADDING = 8;
+
+    static int Scalar(float x, float y, float broad, float coll,
+                      const float* neighborX, const float* neighborY,
+                      const float* neighborBroad, const float* neighborColl,
+                      int count, int* hitIndex, int* hitCollides);
+    static int SSE(float x, float y, float broad, float coll,
+                   const float* neighborX, const float* neighborY,
+                   const float* neighborBroad, const float* neighborColl,
+                   int count, int* hitIndex, int* hitCollides);
+    static int AVX2(float x, float y, float broad, float coll,
+                    const float* neighborX, const float* neighborY,
+                    const float* neighborBroad, const float* neighborColl,
+                    int count, int* hitIndex, int* hitCollides);
+
+    static bool HasSSE();
+    static bool HasAVX2();
+
+    // Melhor kernel suportado pela CPU atual, escolhido uma vez na primeira chamada.
+    static Kernel Select();
+    static const char* SelectedName();
+};
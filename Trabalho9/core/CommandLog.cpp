@@ -0,0 +1,281 @@
+#include "CommandLog.h"
+#include "SimulationSnapshot.h"
+#include <chrono>
+#include <cstring>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr size_t WRITE_CHUNK = 64 * 1024;
+constexpr uint8_t TYPE_MASK = 0x03;
+constexpr uint8_t EDIT_TYPE = 0x03;
+constexpr uint8_t TICK_CHANGED = 0x04;
+constexpr size_t HEADER_BYTES = 2 * sizeof(uint32_t);
+
+void SyncFile(FILE* file) {
+#ifdef _WIN32
+    _commit(_fileno(file));
+#else
+    fsync(fileno(file));
+#endif
+}
+
+void PutVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t)value);
+}
+
+void PutBytes(std::vector<uint8_t>& out, const void* data, size_t size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    out.insert(out.end(), bytes, bytes + size);
+}
+
+void PutFloat(std::vector<uint8_t>& out, float value) { PutBytes(out, &value, sizeof(value)); }
+
+}
+
+std::string CommandLogFileName(const std::string& path, uint32_t index) {
+    char suffix[16];
+    snprintf(suffix, sizeof(suffix), ".%06u", index);
+    return path + suffix;
+}
+
+CommandLogWriter::CommandLogWriter(const CommandLogOptions& options) : options(options), ring(options.ringCapacity) {
+    encoded.reserve(WRITE_CHUNK * 2);
+    worker = std::thread(&CommandLogWriter::WorkerLoop, this);
+}
+
+CommandLogWriter::~CommandLogWriter() {
+    stopping.store(true, std::memory_order_release);
+    worker.join();
+}
+
+void CommandLogWriter::Append(uint32_t tick, const Command& command) {
+    Push({tick, false, command});
+}
+
+void CommandLogWriter::AppendEdit(uint32_t tick) {
+    Push({tick, true, Command()});
+}
+
+void CommandLogWriter::Push(const Entry& entry) {
+    if (!ring.TryPush(entry)) {
+        stallCount++;
+        while (!ring.TryPush(entry)) {
+            std::this_thread::yield();
+        }
+    }
+    appendedCount++;
+}
+
+void CommandLogWriter::Flush() {
+    while (writtenCount.load(std::memory_order_acquire) < appendedCount) {
+        std::this_thread::yield();
+    }
+}
+
+bool CommandLogWriter::OpenNextFile() {
+    CloseFile();
+    file = fopen(CommandLogFileName(options.path, fileCount.load()).c_str(), "wb");
+    if (!file) return false;
+    fileCount++;
+    uint32_t header[2] = {COMMAND_LOG_MAGIC, COMMAND_LOG_VERSION};
+    bool ok = fwrite(header, 1, HEADER_BYTES, file) == HEADER_BYTES;
+    fileBytes = HEADER_BYTES;
+    bytesWritten += HEADER_BYTES;
+    lastTick = 0;
+    return ok;
+}
+
+void CommandLogWriter::CloseFile() {
+    if (!file) return;
+    fflush(file);
+    SyncFile(file);
+    fclose(file);
+    file = nullptr;
+}
+
+void CommandLogWriter::WriteEncoded() {
+    if (encoded.empty()) return;
+    if (!file || fwrite(encoded.data(), 1, encoded.size(), file) != encoded.size()) {
+        failed = true;
+    }
+    fileBytes += encoded.size();
+    bytesWritten += encoded.size();
+    encoded.clear();
+}
+
+void CommandLogWriter::Encode(const Entry& entry) {
+    // Troca de arquivo só entre registros: o primeiro de cada arquivo traz o passo inteiro.
+    if (fileBytes + encoded.size() >= options.maxFileBytes) {
+        WriteEncoded();
+        if (!OpenNextFile()) failed = true;
+    }
+
+    const Command& command = entry.command;
+    uint8_t tag = entry.edit ? EDIT_TYPE : (uint8_t)command.type & TYPE_MASK;
+    bool tickChanged = entry.tick != lastTick;
+    if (tickChanged) tag |= TICK_CHANGED;
+    encoded.push_back(tag);
+    if (tickChanged) {
+        PutVarint(encoded, entry.tick - lastTick);
+        lastTick = entry.tick;
+    }
+    if (entry.edit) {
+        if (encoded.size() >= WRITE_CHUNK) WriteEncoded();
+        return;
+    }
+    PutVarint(encoded, command.agent.index);
+    PutVarint(encoded, command.agent.generation);
+    switch (command.type) {
+        case CommandType::MoveAgent:
+            PutFloat(encoded, command.move.to.x);
+            PutFloat(encoded, command.move.to.y);
+            break;
+        case CommandType::DamageAgent:
+            PutFloat(encoded, command.damage.amount);
+            break;
+        case CommandType::RespawnAgent:
+            PutFloat(encoded, command.respawn.to.x);
+            PutFloat(encoded, command.respawn.to.y);
+            break;
+        case CommandType::Count:
+            break;
+    }
+    if (encoded.size() >= WRITE_CHUNK) WriteEncoded();
+}
+
+void CommandLogWriter::WorkerLoop() {
+    if (!OpenNextFile()) failed = true;
+    auto lastSync = std::chrono::steady_clock::now();
+    const auto syncInterval = std::chrono::milliseconds(options.fsyncIntervalMs);
+
+    Entry entry;
+    while (true) {
+        // Lido antes de esvaziar a fila: tudo o que foi enviado antes do destrutor sai
+        // nesta volta.
+        bool stop = stopping.load(std::memory_order_acquire);
+        uint64_t batch = 0;
+        while (ring.TryPop(entry)) {
+            Encode(entry);
+            batch++;
+        }
+        if (batch > 0) {
+            WriteEncoded();
+            if (file) fflush(file);
+            writtenCount.fetch_add(batch, std::memory_order_release);
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (file && now - lastSync >= syncInterval) {
+            SyncFile(file);
+            lastSync = now;
+        }
+        if (stop) break;
+        if (batch == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CloseFile();
+}
+
+CommandLogReader::CommandLogReader(const std::string& path) : path(path) {
+    open = OpenFile(0);
+}
+
+bool CommandLogReader::OpenFile(uint32_t index) {
+    data.clear();
+    offset = 0;
+    tick = 0;
+    if (!ReadSnapshotFile(CommandLogFileName(path, index), data)) return false;
+    uint32_t header[2];
+    if (data.size() < HEADER_BYTES) {
+        failed = true;
+        return false;
+    }
+    std::memcpy(header, data.data(), HEADER_BYTES);
+    if (header[0] != COMMAND_LOG_MAGIC || header[1] != COMMAND_LOG_VERSION) {
+        failed = true;
+        return false;
+    }
+    fileIndex = index;
+    filesOpened++;
+    offset = HEADER_BYTES;
+    return true;
+}
+
+bool CommandLogReader::ReadVarint(uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (offset >= data.size()) return false;
+        uint8_t byte = data[offset++];
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+bool CommandLogReader::ReadFloat(float& value) {
+    if (data.size() - offset < sizeof(float)) return false;
+    std::memcpy(&value, data.data() + offset, sizeof(float));
+    offset += sizeof(float);
+    return true;
+}
+
+bool CommandLogReader::Next(uint32_t& recordTick, Command& command) {
+    while (true) {
+        while (open && offset == data.size()) {
+            open = OpenFile(fileIndex + 1);
+        }
+        if (!open) return false;
+        
+        uint8_t tag = data[offset++];
+        uint64_t tickDelta = 0, index = 0, generation = 0;
+        bool ok = !(tag & TICK_CHANGED) || ReadVarint(tickDelta);
+        bool edit = (tag & TYPE_MASK) == EDIT_TYPE;
+        if (!edit) ok = ok && ReadVarint(index) && ReadVarint(generation);
+        AgentHandle agent = {(uint32_t)index, (uint32_t)generation};
+        Vector2 to = {0.0f, 0.0f};
+        float amount = 0.0f;
+        switch ((CommandType)(tag & TYPE_MASK)) {
+            case CommandType::MoveAgent:
+                ok = ok && ReadFloat(to.x) && ReadFloat(to.y);
+                command = Command::Move(agent, to, to);
+                break;
+            case CommandType::DamageAgent:
+                ok = ok && ReadFloat(amount);
+                command = Command::Damage(agent, amount);
+                break;
+            case CommandType::RespawnAgent:
+                ok = ok && ReadFloat(to.x) && ReadFloat(to.y);
+                command = Command::Respawn(agent);
+                command.respawn.to = to;
+                break;
+            default:
+                break;
+        }
+        if (!ok) {
+            // Registro incompleto: normal no fim do último arquivo, erro antes dele.
+            if (std::FILE* next = fopen(CommandLogFileName(path, fileIndex + 1).c_str(), "rb")) {
+                fclose(next);
+                failed = true;
+            } else {
+                truncated = true;
+            }
+            open = false;
+            return false;
+        }
+        tick += (uint32_t)tickDelta;
+        if (edit) {
+            if (editCount++ == 0) firstEditTick = tick;
+            continue;
+        }
+        recordTick = tick;
+        return true;
+    }
+}
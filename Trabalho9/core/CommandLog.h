@@ -0,0 +1,128 @@
+#pragma once
+#include "Command.h"
+#include "SpscRing.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Log de comandos executados (write-ahead log), para auditoria e replay. A simulação só
+// copia cada comando para uma SpscRing; uma thread própria codifica, grava, faz fsync
+// periódico e troca de arquivo quando o atual passa de maxFileBytes. Os arquivos são
+// `path.000000`, `path.000001`, ..., cada um com cabeçalho próprio.
+//
+// Cada registro é uma tag de um byte (tipo nos bits 0-1, bit 2 se o passo mudou, seguido
+// do avanço em varint), slot e geração do agente em varint e os campos do tipo que
+// reproduzem o efeito: destino do movimento, quantidade de dano, destino do respawn. Um
+// movimento ocupa uns 12 bytes, contra 40 do Command.
+//
+// O que muda o estado sem passar por um comando executado (desfazer, edição do grid,
+// agente criado ou removido, snapshot restaurado) não tem como ser reaplicado. Essas
+// mudanças gravam um registro de edição (tipo 3, só com o passo), e o replay para nele.
+constexpr uint32_t COMMAND_LOG_MAGIC = 0x5741564E;  // "NVAW"
+constexpr uint32_t COMMAND_LOG_VERSION = 1;
+
+struct CommandLogOptions {
+    std::string path;
+    // Registros que cabem na fila; se ela encher, Append espera a thread de escrita.
+    size_t ringCapacity = 1 << 16;
+    int fsyncIntervalMs = 1000;
+    uint64_t maxFileBytes = 64ull << 20;
+};
+
+std::string CommandLogFileName(const std::string& path, uint32_t index);
+
+class CommandLogWriter {
+private:
+    struct Entry {
+        uint32_t tick;
+        bool edit;
+        Command command;
+    };
+
+    CommandLogOptions options;
+    SpscRing<Entry> ring;
+    std::thread worker;
+    std::atomic<bool> stopping{false};
+    // Quantos Append já foram codificados e entregues ao arquivo (após fflush).
+    std::atomic<uint64_t> writtenCount{0};
+    uint64_t appendedCount = 0;
+
+    std::atomic<uint64_t> bytesWritten{0};
+    std::atomic<uint32_t> fileCount{0};
+    std::atomic<bool> failed{false};
+    uint64_t stallCount = 0;
+
+    // Estado da thread de escrita.
+    FILE* file = nullptr;
+    uint64_t fileBytes = 0;
+    uint32_t lastTick = 0;
+    std::vector<uint8_t> encoded;
+
+    void Push(const Entry& entry);
+    bool OpenNextFile();
+    void CloseFile();
+    void Encode(const Entry& entry);
+    void WriteEncoded();
+    void WorkerLoop();
+
+public:
+    explicit CommandLogWriter(const CommandLogOptions& options);
+    // Grava tudo o que estiver na fila, faz fsync e fecha o arquivo.
+    ~CommandLogWriter();
+
+    CommandLogWriter(const CommandLogWriter&) = delete;
+    CommandLogWriter& operator=(const CommandLogWriter&) = delete;
+
+    // Só da thread da simulação (produtor único). `command` já executado: os campos
+    // preenchidos na execução (destino do respawn) vão para o log.
+    void Append(uint32_t tick, const Command& command);
+    // Registra que o estado mudou por fora dos comandos no passo `tick`.
+    void AppendEdit(uint32_t tick);
+    // Bloqueia até tudo o que foi enviado estar no arquivo (sem esperar o fsync).
+    void Flush();
+
+    uint64_t GetRecordCount() const { return appendedCount; }
+    uint64_t GetBytesWritten() const { return bytesWritten.load(); }
+    uint32_t GetFileCount() const { return fileCount.load(); }
+    // Vezes em que Append encontrou a fila cheia.
+    uint64_t GetStallCount() const { return stallCount; }
+    bool Failed() const { return failed.load(); }
+};
+
+// Lê os arquivos de um log em sequência. Um registro cortado no fim do último arquivo
+// (queda durante a escrita) encerra a leitura sem erro; Truncated() fica true.
+class CommandLogReader {
+private:
+    std::string path;
+    uint32_t fileIndex = 0;
+    uint32_t filesOpened = 0;
+    std::vector<uint8_t> data;
+    size_t offset = 0;
+    uint32_t tick = 0;
+    bool open = false;
+    bool failed = false;
+    bool truncated = false;
+    uint64_t editCount = 0;
+    uint32_t firstEditTick = 0;
+
+    bool OpenFile(uint32_t index);
+    bool ReadVarint(uint64_t& value);
+    bool ReadFloat(float& value);
+
+public:
+    explicit CommandLogReader(const std::string& path);
+
+    // Próximo comando; false no fim do log ou se um arquivo for inválido (Failed()). Os
+    // registros de edição no caminho só são contados (GetEditCount).
+    bool Next(uint32_t& recordTick, Command& command);
+
+    uint32_t GetFileCount() const { return filesOpened; }
+    bool Failed() const { return failed; }
+    bool Truncated() const { return truncated; }
+    // Registros de edição lidos até agora e o passo do primeiro.
+    uint64_t GetEditCount() const { return editCount; }
+    uint32_t GetFirstEditTick() const { return firstEditTick; }
+};
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+
+// Gerador baseado em contador (Squares, Widynski 2020): cada número é uma função pura
+// de (chave, contador), sem estado compartilhado. Qualquer thread pode sortear o valor
+// da célula (x, y) sem depender da ordem em que as outras foram sorteadas.
+class CounterRng {
+private:
+    uint64_t key;
+    
+public:
+    static uint64_t Mix(uint64_t x) {
+        x += 0x9e3779b97f4a7c15ull;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+    
+    // A chave precisa ser ímpar e ter bits bem distribuídos; derivamos de (seed, stream).
+    CounterRng(uint64_t seed, uint64_t stream = 0) : key(Mix(seed ^ Mix(stream)) | 1) {}
+    
+    uint32_t At(uint64_t counter) const {
+        uint64_t x = counter * key;
+        uint64_t y = x;
+        uint64_t z = y + key;
+        x = x * x + y; x = (x >> 32) | (x << 32);
+        x = x * x + z; x = (x >> 32) | (x << 32);
+        x = x * x + y; x = (x >> 32) | (x << 32);
+        return (uint32_t)((x * x + z) >> 32);
+    }
+    
+    uint32_t At(uint32_t a, uint32_t b) const {
+        return At(((uint64_t)a << 32) | b);
+    }
+    
+    float UniformAt(uint32_t a, uint32_t b) const {
+        return (At(a, b) >> 8) * (1.0f / 16777216.0f);
+    }
+    
+    // Inteiro em [min, max], como GetRandomValue.
+    int RangeAt(uint32_t a, uint32_t b, int min, int max) const {
+        return min + (int)(((uint64_t)At(a, b) * (uint64_t)(max - min + 1)) >> 32);
+    }
+};
@@ -0,0 +1,93 @@
+#include "Clock.h"
+#include "Metrics.h"
+#include "DialPathfinder.h"
+#include "AStarPathfinder.h"
+#include "SearchScratch.h"
+
+thread_local double DialPathfinder::lastExecutionTime = 0.0;
+
+namespace {
+thread_local SearchScratch scratch;
+thread_local std::vector<std::vector<int>> buckets;
+}
+
+std::vector<Vector2> DialPathfinder::FindPath(Grid& grid, Vector2 start, Vector2 end, const std::string& distribution,
+                                              int minClearance) {
+    double startTime = Clock::Now();
+    
+    int width = grid.GetWidth();
+    int sx = (int)start.x, sy = (int)start.y;
+    int ex = (int)end.x, ey = (int)end.y;
+    
+    if (!grid.IsWalkable(sx, sy) || !grid.IsWalkable(ex, ey)) {
+        return {};
+    }
+    
+    scratch.Prepare(width * grid.GetHeight());
+    buckets.resize(BUCKET_COUNT);
+    for (auto& bucket : buckets) bucket.clear();
+    
+    int startIndex = sy * width + sx;
+    int endIndex = ey * width + ex;
+    
+    scratch.Visit(startIndex, 0, -1);
+    int currentF = AStarPathfinder::CalculateHeuristic(sx, sy, ex, ey);
+    buckets[currentF % BUCKET_COUNT].push_back(startIndex);
+    int pending = 1;
+    
+    const int directions[4][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
+    
+    while (pending > 0) {
+        std::vector<int>& bucket = buckets[currentF % BUCKET_COUNT];
+        if (bucket.empty()) {
+            currentF++;
+            continue;
+        }
+        
+        int index = bucket.back();
+        bucket.pop_back();
+        pending--;
+        
+        if (scratch.IsClosed(index)) continue;
+        
+        int cx = index % width;
+        int cy = index / width;
+        int currentG = scratch.gCost[index];
+        
+        // Entrada obsoleta: a célula foi reinserida com fCost menor.
+        if (currentG + AStarPathfinder::CalculateHeuristic(cx, cy, ex, ey) != currentF) continue;
+        
+        scratch.Close(index);
+        
+        if (index == endIndex) {
+            lastExecutionTime = Clock::Now() - startTime;
+            std::vector<Vector2> path = AStarPathfinder::ReconstructPath(scratch, endIndex, width);
+            Metrics::RecordPathfinding(Metrics::GetAgentCount(), width, grid.GetHeight(), lastExecutionTime,
+                                       (int)path.size(), distribution);
+            return path;
+        }
+        
+        for (auto& dir : directions) {
+            int nx = cx + dir[0];
+            int ny = cy + dir[1];
+            
+            if (!grid.IsWalkable(nx, ny)) continue;
+            
+            int neighbor = ny * width + nx;
+            if (neighbor != endIndex && grid.GetClearance(nx, ny) < minClearance) continue;
+            if (scratch.IsClosed(neighbor)) continue;
+            
+            int newGCost = currentG + grid.GetTerrainCost(nx, ny);
+            if (!scratch.IsVisited(neighbor) || newGCost < scratch.gCost[neighbor]) {
+                scratch.Visit(neighbor, newGCost, index);
+                int f = newGCost + AStarPathfinder::CalculateHeuristic(nx, ny, ex, ey);
+                buckets[f % BUCKET_COUNT].push_back(neighbor);
+                pending++;
+            }
+        }
+    }
+    
+    lastExecutionTime = Clock::Now() - startTime;
+    Metrics::RecordPathfinding(Metrics::GetAgentCount(), width, grid.GetHeight(), lastExecutionTime, 0, distribution);
+    return {};
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include "Pathfinder.h"
+#include "Grid.h"
+#include <vector>
+
+// A* com fila de baldes (algoritmo de Dial). Como os custos de terreno são inteiros
+// entre 1 e 255 e a heurística de Manhattan é consistente, o fCost de um vizinho
+// nunca passa de fCost + 256; basta um anel de 257 baldes, sem heap.
+class DialPathfinder : public Pathfinder {
+private:
+    static constexpr int BUCKET_COUNT = 257;
+    static thread_local double lastExecutionTime;
+    
+public:
+    std::vector<Vector2> FindPath(Grid& grid, Vector2 start, Vector2 end, 
+                                 const std::string& distribution = "random",
+                                 int minClearance = 0) override;
+    double GetLastExecutionTime() override { return lastExecutionTime; }
+};
@@ -1,4 +1,7 @@
 #include "Grid.h"
+#include "Random.h"
+#include <algorithm>
+#include <cmath>
 
 std::unique_ptr<Grid> Grid::instance = nullptr;
 
@@ -10,6 +13,14 @@ Grid::Grid(int w, int h, float cell_size) : width(w), height(h), cell_size(cell_
             nodes[y][x] = Node(x, y); 
         }
     }
+    terrainCost.assign(width * height, 1);
+    freeCells.resize(width * height);
+    freeSlot.resize(width * height);
+    for (int cell = 0; cell < width * height; cell++) {
+        freeCells[cell] = cell;
+        freeSlot[cell] = cell;
+    }
+    RecomputeClearance();
 }
 
 Grid& Grid::GetInstance() {
@@ -30,29 +41,69 @@ void Grid::DestroyInstance() {
     instance.reset();
 }
 
-void Grid::Draw() {
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            Color color = nodes[y][x].occupied ? RED : GREEN;
-            if (!nodes[y][x].walkable) color = DARKGRAY;
-            
-            DrawRectangle(x * cell_size, y * cell_size, cell_size - 1, cell_size - 1, color);
-            DrawRectangleLines(x * cell_size, y * cell_size, cell_size, cell_size, LIGHTGRAY);
-        }
+void Grid::MarkDirty(int x, int y) {
+    if ((int)dirtyLog.size() >= width * height) {
+        dirtyLogBase += dirtyLog.size();
+        dirtyLog.clear();
     }
+    dirtyLog.push_back(y * width + x);
 }
 
-void Grid::SetOccupied(int x, int y, bool occupied) {
-    if (IsValidPosition(x, y)) {
-        nodes[y][x].occupied = occupied;
-        nodes[y][x].walkable = !occupied;
+bool Grid::CollectDirtyCells(uint64_t& cursor, std::vector<int>& out) const {
+    uint64_t end = dirtyLogBase + dirtyLog.size();
+    if (cursor < dirtyLogBase) {
+        cursor = end;
+        return false;
     }
+    out.insert(out.end(), dirtyLog.begin() + (cursor - dirtyLogBase), dirtyLog.end());
+    cursor = end;
+    return true;
+}
+
+void Grid::SetOccupied(int x, int y, bool occupied) {
+    SetWalkable(x, y, !occupied);
 }
 
 void Grid::SetWalkable(int x, int y, bool walkable) {
-    if (IsValidPosition(x, y)) {
-        nodes[y][x].walkable = walkable;
-        nodes[y][x].occupied = !walkable;
+    if (!IsValidPosition(x, y)) return;
+    
+    bool wasWalkable = nodes[y][x].walkable;
+    nodes[y][x].walkable = walkable;
+    nodes[y][x].occupied = !walkable;
+    
+    if (wasWalkable != walkable) {
+        MarkDirty(x, y);
+        componentsDirty = true;
+        
+        int cell = y * width + x;
+        if (walkable) {
+            freeSlot[cell] = (int)freeCells.size();
+            freeCells.push_back(cell);
+        } else {
+            int slot = freeSlot[cell];
+            int last = freeCells.back();
+            freeCells[slot] = last;
+            freeSlot[last] = slot;
+            freeCells.pop_back();
+            freeSlot[cell] = -1;
+        }
+    }
+    if (batchEditDepth > 0) return;
+    
+    if (wasWalkable && !walkable) {
+        LowerClearanceAround(x, y);
+    } else if (!wasWalkable && walkable) {
+        RaiseClearanceAround(x, y);
+    }
+}
+
+void Grid::SetTerrainCost(int x, int y, uint8_t cost) {
+    if (!IsValidPosition(x, y)) return;
+    
+    uint8_t newCost = cost > 0 ? cost : 1;
+    if (terrainCost[y * width + x] != newCost) {
+        terrainCost[y * width + x] = newCost;
+        MarkDirty(x, y);
     }
 }
 
@@ -79,4 +130,276 @@ void Grid::ResetPathfindingData() {
             nodes[y][x].parent = nullptr;
         }
     }
+}
+
+bool Grid::RandomFreeCell(int& x, int& y) const {
+    if (freeCells.empty()) return false;
+    int cell = freeCells[Random::Range(0, (int)freeCells.size() - 1)];
+    x = cell % width;
+    y = cell / width;
+    return true;
+}
+
+// Rotula as componentes com uma busca em largura por componente e depois agrupa as
+// células por rótulo (counting sort), para sortear dentro de uma componente em O(1).
+void Grid::UpdateComponents() {
+    if (!componentsDirty) return;
+    componentsDirty = false;
+    
+    const int cellCount = width * height;
+    componentOf.assign(cellCount, -1);
+    std::vector<int> queue;
+    queue.reserve(freeCells.size());
+    int componentCount = 0;
+    
+    for (int start = 0; start < cellCount; start++) {
+        if (componentOf[start] >= 0 || freeSlot[start] < 0) continue;
+        int component = componentCount++;
+        componentOf[start] = component;
+        queue.clear();
+        queue.push_back(start);
+        for (size_t head = 0; head < queue.size(); head++) {
+            int cell = queue[head];
+            int cx = cell % width;
+            int cy = cell / width;
+            const int neighbors[4][2] = {{cx, cy + 1}, {cx + 1, cy}, {cx, cy - 1}, {cx - 1, cy}};
+            for (auto& neighbor : neighbors) {
+                if (!IsWalkable(neighbor[0], neighbor[1])) continue;
+                int next = neighbor[1] * width + neighbor[0];
+                if (componentOf[next] >= 0) continue;
+                componentOf[next] = component;
+                queue.push_back(next);
+            }
+        }
+    }
+    
+    componentStart.assign(componentCount + 1, 0);
+    for (int cell = 0; cell < cellCount; cell++) {
+        if (componentOf[cell] >= 0) componentStart[componentOf[cell] + 1]++;
+    }
+    for (int component = 0; component < componentCount; component++) {
+        componentStart[component + 1] += componentStart[component];
+    }
+    componentCells.resize(componentStart[componentCount]);
+    std::vector<int> cursor(componentStart.begin(), componentStart.end() - 1);
+    for (int cell = 0; cell < cellCount; cell++) {
+        if (componentOf[cell] >= 0) componentCells[cursor[componentOf[cell]]++] = cell;
+    }
+}
+
+int Grid::GetComponent(int x, int y) {
+    if (!IsValidPosition(x, y)) return -1;
+    UpdateComponents();
+    return componentOf[y * width + x];
+}
+
+int Grid::GetComponentSize(int component) {
+    UpdateComponents();
+    if (component < 0 || component + 1 >= (int)componentStart.size()) return 0;
+    return componentStart[component + 1] - componentStart[component];
+}
+
+bool Grid::RandomFreeCellInComponent(int component, int& x, int& y) {
+    int size = GetComponentSize(component);
+    if (size == 0) return false;
+    int cell = componentCells[componentStart[component] + Random::Range(0, size - 1)];
+    x = cell % width;
+    y = cell / width;
+    return true;
+}
+
+// Transformada de distância em duas passadas (chamfer 3x3), exata para a métrica de Chebyshev.
+void Grid::RecomputeClearance() {
+    const uint16_t inf = UINT16_MAX;
+    clearance.assign(width * height, inf);
+    
+    auto at = [&](int x, int y) -> int {
+        return IsValidPosition(x, y) ? clearance[y * width + x] : 0;
+    };
+    
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (!nodes[y][x].walkable) {
+                clearance[y * width + x] = 0;
+                continue;
+            }
+            int best = std::min({at(x - 1, y), at(x - 1, y - 1), at(x, y - 1), at(x + 1, y - 1)}) + 1;
+            clearance[y * width + x] = (uint16_t)std::min<int>(best, inf);
+        }
+    }
+    
+    for (int y = height - 1; y >= 0; y--) {
+        for (int x = width - 1; x >= 0; x--) {
+            uint16_t& c = clearance[y * width + x];
+            if (c == 0) continue;
+            int best = std::min({at(x + 1, y), at(x + 1, y + 1), at(x, y + 1), at(x - 1, y + 1)}) + 1;
+            if (best < c) c = (uint16_t)best;
+        }
+    }
+}
+
+// Um novo obstaculo só pode diminuir a clearance. Propaga em anéis ao redor de (x, y)
+// e para no primeiro anel em que nenhuma célula mudou.
+void Grid::LowerClearanceAround(int x, int y) {
+    clearance[y * width + x] = 0;
+    
+    int maxRing = std::max(width, height);
+    for (int r = 1; r <= maxRing; r++) {
+        bool changed = false;
+        for (int cy = y - r; cy <= y + r; cy++) {
+            for (int cx = x - r; cx <= x + r; cx += (cy == y - r || cy == y + r) ? 1 : 2 * r) {
+                if (!IsValidPosition(cx, cy)) continue;
+                uint16_t& c = clearance[cy * width + cx];
+                if (c > r) {
+                    c = (uint16_t)r;
+                    changed = true;
+                }
+            }
+        }
+        if (!changed) break;
+    }
+}
+
+// Remover um obstaculo só pode aumentar a clearance das células cujo valor vinha dele
+// (clearance == distância ate (x, y)). Essas células são invalidadas e recalculadas
+// com a mesma transformada em duas passadas, restrita à janela afetada.
+void Grid::RaiseClearanceAround(int x, int y) {
+    const uint16_t inf = UINT16_MAX;
+    clearance[y * width + x] = inf;
+    
+    int radius = 0;
+    int maxRing = std::max(width, height);
+    for (int r = 1; r <= maxRing; r++) {
+        bool affected = false;
+        for (int cy = y - r; cy <= y + r; cy++) {
+            for (int cx = x - r; cx <= x + r; cx += (cy == y - r || cy == y + r) ? 1 : 2 * r) {
+                if (!IsValidPosition(cx, cy)) continue;
+                uint16_t& c = clearance[cy * width + cx];
+                if (c == r) {
+                    c = inf;
+                    affected = true;
+                }
+            }
+        }
+        if (!affected) break;
+        radius = r;
+    }
+    
+    int x0 = std::max(0, x - radius), x1 = std::min(width - 1, x + radius);
+    int y0 = std::max(0, y - radius), y1 = std::min(height - 1, y + radius);
+    
+    auto at = [&](int cx, int cy) -> int {
+        return IsValidPosition(cx, cy) ? clearance[cy * width + cx] : 0;
+    };
+    
+    for (int cy = y0; cy <= y1; cy++) {
+        for (int cx = x0; cx <= x1; cx++) {
+            uint16_t& c = clearance[cy * width + cx];
+            if (c == 0) continue;
+            int best = std::min({at(cx - 1, cy), at(cx - 1, cy - 1), at(cx, cy - 1), at(cx + 1, cy - 1),
+                                 at(cx + 1, cy), at(cx - 1, cy + 1)}) + 1;
+            if (best < c) c = (uint16_t)best;
+        }
+    }
+    for (int cy = y1; cy >= y0; cy--) {
+        for (int cx = x1; cx >= x0; cx--) {
+            uint16_t& c = clearance[cy * width + cx];
+            if (c == 0) continue;
+            int best = std::min({at(cx + 1, cy), at(cx + 1, cy + 1), at(cx, cy + 1), at(cx - 1, cy + 1),
+                                 at(cx - 1, cy), at(cx + 1, cy - 1)}) + 1;
+            if (best < c) c = (uint16_t)best;
+        }
+    }
+}
+
+void Grid::ApplyObstacleMask(const std::vector<uint8_t>& blocked) {
+    BeginBatchEdit();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            SetWalkable(x, y, blocked[y * width + x] == 0);
+        }
+    }
+    EndBatchEdit();
+}
+
+void Grid::SaveSnapshot(SnapshotWriter& out) const {
+    out.Write(width);
+    out.Write(height);
+    out.Write(cell_size);
+    std::vector<uint8_t> blocked(width * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            blocked[y * width + x] = nodes[y][x].walkable ? 0 : 1;
+        }
+    }
+    out.WriteVector(blocked);
+    out.WriteVector(terrainCost);
+    out.WriteVector(freeCells);
+}
+
+bool Grid::ReadSnapshot(SnapshotReader& in, SnapshotData& data) {
+    if (!in.Read(data.width) || !in.Read(data.height) || !in.Read(data.cellSize) ||
+        !in.ReadVector(data.blocked) || !in.ReadVector(data.terrainCost) || !in.ReadVector(data.freeCells)) {
+        return false;
+    }
+    if (data.width <= 0 || data.height <= 0 || data.cellSize <= 0.0f) return in.Fail();
+    const int cellCount = data.width * data.height;
+    if ((int)data.blocked.size() != cellCount || (int)data.terrainCost.size() != cellCount) return in.Fail();
+    
+    // freeCells precisa ser uma permutação das células livres.
+    data.freeSlot.assign(cellCount, -1);
+    int freeCount = 0;
+    for (int cell = 0; cell < cellCount; cell++) {
+        if (data.blocked[cell] == 0) freeCount++;
+    }
+    if ((int)data.freeCells.size() != freeCount) return in.Fail();
+    for (int slot = 0; slot < freeCount; slot++) {
+        int cell = data.freeCells[slot];
+        if (cell < 0 || cell >= cellCount || data.blocked[cell] != 0 || data.freeSlot[cell] >= 0) return in.Fail();
+        data.freeSlot[cell] = slot;
+    }
+    return true;
+}
+
+void Grid::ApplySnapshot(SnapshotData& data) {
+    width = data.width;
+    height = data.height;
+    cell_size = data.cellSize;
+    nodes.assign(height, std::vector<Node>(width));
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            Node& node = nodes[y][x];
+            node = Node(x, y);
+            node.walkable = data.blocked[y * width + x] == 0;
+            node.occupied = !node.walkable;
+        }
+    }
+    data.blocked.clear();
+    terrainCost = std::move(data.terrainCost);
+    freeCells = std::move(data.freeCells);
+    freeSlot = std::move(data.freeSlot);
+    componentsDirty = true;
+    batchEditDepth = 0;
+    
+    // Descarta o log: todo cursor antigo fica antes da nova base.
+    dirtyLogBase += dirtyLog.size() + 1;
+    dirtyLog.clear();
+    
+    RecomputeClearance();
+}
+
+void Grid::EndBatchEdit() {
+    if (batchEditDepth > 0 && --batchEditDepth == 0) {
+        RecomputeClearance();
+    }
+}
+
+int Grid::GetClearance(int x, int y) const {
+    return IsValidPosition(x, y) ? clearance[y * width + x] : 0;
+}
+
+// Clearance mínima para que um círculo de raio `radius` (em pixels), centrado na célula,
+// não encoste em nenhum obstáculo.
+int Grid::ClearanceForRadius(float radius) const {
+    return (int)std::ceil(radius / cell_size + 0.5f);
 }
\ No newline at end of file
@@ -1,8 +1,10 @@
 #pragma once
-#include "raylib.h"
+#include "NavTypes.h"
 #include "Node.h"
+#include "Snapshot.h"
 #include <vector>
 #include <memory>
+#include <cstdint>
 
 class Grid {
 private:
@@ -12,6 +14,42 @@ private:
     float cell_size;
     std::vector<std::vector<Node>> nodes;
     
+    // Distância (Chebyshev, em células) de cada célula até o obstáculo mais próximo.
+    // Obstáculos valem 0 e a borda do grid conta como obstáculo.
+    std::vector<uint16_t> clearance;
+    
+    // Custo para entrar em cada célula (1 = terreno normal, 255 = mais lento).
+    std::vector<uint8_t> terrainCost;
+    
+    // Enquanto > 0, edições não atualizam a clearance; EndBatchEdit recalcula tudo de uma vez.
+    int batchEditDepth = 0;
+    
+    // Log de células alteradas (y * width + x). Cada consumidor guarda um cursor na
+    // sequência; quando o log passa do número de células ele é descartado e consumidores
+    // atrasados redesenham tudo.
+    std::vector<int> dirtyLog;
+    uint64_t dirtyLogBase = 0;
+    
+    // Índice das células livres: freeCells guarda as células caminháveis (y * width + x)
+    // em ordem arbitrária e freeSlot a posição de cada uma em freeCells (-1 se bloqueada).
+    // Inserir e remover trocam com a última, então sortear uma célula livre é O(1).
+    std::vector<int> freeCells;
+    std::vector<int> freeSlot;
+    
+    // Componentes conexas das células livres (4-vizinhança, como os pathfinders). São
+    // recalculadas na primeira consulta depois de uma edição: componentCells lista as
+    // células agrupadas por componente, a partir de componentStart[c].
+    std::vector<int> componentOf;
+    std::vector<int> componentStart;
+    std::vector<int> componentCells;
+    bool componentsDirty = true;
+    
+    void MarkDirty(int x, int y);
+    void UpdateComponents();
+    
+    void LowerClearanceAround(int x, int y);
+    void RaiseClearanceAround(int x, int y);
+    
 public:
     Grid(int w, int h, float cell_size);
     
@@ -22,7 +60,6 @@ public:
     static Grid& CreateInstance(int w, int h, float cell_size);
     static void DestroyInstance();
     
-    void Draw();
     void SetOccupied(int x, int y, bool occupied);
     void SetWalkable(int x, int y, bool walkable);
     bool IsValidPosition(int x, int y) const;
@@ -30,7 +67,55 @@ public:
     Node* GetNode(int x, int y);
     void ResetPathfindingData();
     
+    void SetTerrainCost(int x, int y, uint8_t cost);
+    int GetTerrainCost(int x, int y) const { return terrainCost[y * width + x]; }
+    
+    // blocked[y * width + x] != 0 vira obstáculo; substitui todos os obstáculos do grid.
+    void ApplyObstacleMask(const std::vector<uint8_t>& blocked);
+    
+    // Copia para `out` as células alteradas desde `cursor` e avança o cursor.
+    // Retorna false quando o histórico já foi descartado: o consumidor deve redesenhar tudo.
+    bool CollectDirtyCells(uint64_t& cursor, std::vector<int>& out) const;
+    
+    void BeginBatchEdit() { batchEditDepth++; }
+    void EndBatchEdit();
+    
+    int GetFreeCellCount() const { return (int)freeCells.size(); }
+    // Sorteia (com Random) uma célula livre, uniforme. Retorna false se não houver nenhuma.
+    bool RandomFreeCell(int& x, int& y) const;
+    
+    // Componente conexa da célula, ou -1 se ela estiver bloqueada. Pode recalcular as
+    // componentes (O(células)), então não deve ser chamada durante UpdateAll.
+    int GetComponent(int x, int y);
+    int GetComponentSize(int component);
+    // Como RandomFreeCell, restrito a uma componente: o resultado alcança (x, y) inicial.
+    bool RandomFreeCellInComponent(int component, int& x, int& y);
+    
+    // Obstáculos, custos de terreno e a ordem das células livres (que decide os sorteios
+    // de RandomFreeCell). Clearance e componentes são derivadas e recalculadas ao carregar.
+    void SaveSnapshot(SnapshotWriter& out) const;
+    
+    // Grid lido e validado de um snapshot, ainda não aplicado.
+    struct SnapshotData {
+        int width = 0;
+        int height = 0;
+        float cellSize = 0.0f;
+        std::vector<uint8_t> blocked;
+        std::vector<uint8_t> terrainCost;
+        std::vector<int> freeCells;
+        std::vector<int> freeSlot;
+    };
+    // Retorna false se os dados forem inválidos; não mexe em nenhum grid.
+    static bool ReadSnapshot(SnapshotReader& in, SnapshotData& data);
+    // Substitui o grid pelo lido, inclusive as dimensões. Consumidores do log de células
+    // alteradas redesenham tudo. `data` fica vazio.
+    void ApplySnapshot(SnapshotData& data);
+    
+    void RecomputeClearance();
+    int GetClearance(int x, int y) const;
+    int ClearanceForRadius(float radius) const;
+    
     int GetWidth() const { return width; }
     int GetHeight() const { return height; }
     float GetCellSize() const { return cell_size; }
-};
\ No newline at end of file
+};
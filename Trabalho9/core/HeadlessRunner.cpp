@@ -0,0 +1,171 @@
+#include "HeadlessRunner.h"
+#include "AgentManager.h"
+#include "Grid.h"
+#include "Simulation.h"
+#include "SimulationSnapshot.h"
+#include "CheckpointWriter.h"
+#include "CommandLog.h"
+#include "ThreadPool.h"
+#include "Random.h"
+#include "Metrics.h"
+#include "CollisionMetricsSubscriber.h"
+#include "NoiseObstacleFactory.h"
+#include "MazeObstacleFactory.h"
+#include "RoomsObstacleFactory.h"
+#include "CityBlockObstacleFactory.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+std::unique_ptr<ProceduralObstacleFactory> CreateMapGenerator(const std::string& name, uint64_t seed) {
+    if (name == "noise") return std::make_unique<NoiseObstacleFactory>(seed, 4.0f);
+    if (name == "maze") return std::make_unique<MazeObstacleFactory>(seed);
+    if (name == "rooms") return std::make_unique<RoomsObstacleFactory>(seed, 6);
+    if (name == "city") return std::make_unique<CityBlockObstacleFactory>(seed, 5, 1);
+    return nullptr;
+}
+
+int RunHeadless(const HeadlessOptions& options) {
+    if (options.threads > 0) {
+        ThreadPool::CreateInstance(options.threads);
+    }
+    Random::Seed(options.seed);
+    
+    Grid grid(options.width, options.height, 20.0f);
+    AgentManager agentManager(&grid);
+    Simulation simulation(agentManager);
+    if (!options.restore.empty()) {
+        std::vector<uint8_t> snapshot;
+        if (!ReadSnapshotFile(options.restore, snapshot) || !RestoreSnapshot(snapshot, grid, simulation, agentManager)) {
+            fprintf(stderr, "Snapshot inválido: %s\n", options.restore.c_str());
+            ThreadPool::DestroyInstance();
+            return 1;
+        }
+        printf("Restaurado de %s no tick %llu\n", options.restore.c_str(), (unsigned long long)simulation.GetTick());
+    } else {
+        auto mapGenerator = CreateMapGenerator(options.map, options.seed);
+        if (mapGenerator) {
+            mapGenerator->CreateObstacles(grid, 0);
+        }
+        agentManager.SetWorldSeed(options.seed);
+        agentManager.SetSteeringEnabled(options.steering);
+        agentManager.AddRandomAgents(options.agents);
+    }
+    CollisionMetricsSubscriber collisionMetrics;
+    agentManager.GetCollisionEvents().Subscribe(&collisionMetrics);
+    
+    std::unique_ptr<CommandLogWriter> commandLog;
+    if (!options.commandLog.empty()) {
+        CommandLogOptions logOptions;
+        logOptions.path = options.commandLog;
+        commandLog = std::make_unique<CommandLogWriter>(logOptions);
+        agentManager.SetCommandLog(commandLog.get());
+    }
+    
+    CheckpointWriter checkpointWriter;
+    std::vector<uint8_t> checkpoint;
+    double captureSeconds = 0.0;
+    int captures = 0;
+    uint64_t interval = options.checkpoint.empty() || options.checkpointEvery == 0 ? options.ticks : options.checkpointEvery;
+    
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t done = 0; done < options.ticks;) {
+        uint64_t steps = std::min(interval, options.ticks - done);
+        simulation.RunTicks(steps);
+        done += steps;
+        if (!options.checkpoint.empty()) {
+            auto captureStart = std::chrono::steady_clock::now();
+            CaptureSnapshot(grid, simulation, agentManager, checkpoint);
+            captureSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - captureStart).count();
+            captures++;
+            checkpointWriter.Submit(checkpoint, options.checkpoint);
+        }
+    }
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    checkpointWriter.Flush();
+    if (commandLog) {
+        commandLog->Flush();
+        agentManager.SetCommandLog(nullptr);
+    }
+    
+    printf("Grid %dx%d (%s) | %d agentes | %d threads | ORCA %s\n", grid.GetWidth(), grid.GetHeight(),
+           options.restore.empty() ? options.map.c_str() : "snapshot", agentManager.GetAgentCount(),
+           ThreadPool::GetInstance().GetThreadCount(), agentManager.IsSteeringEnabled() ? "ligado" : "desligado");
+    printf("Ticks: %llu | Tempo simulado: %.1f s | Tempo real: %.2f s | %.1fx tempo real\n",
+           (unsigned long long)simulation.GetTick(), simulation.GetSimulationTime(), wallSeconds,
+           wallSeconds > 0 ? simulation.GetSimulationTime() / wallSeconds : 0.0);
+    printf("Contatos: %lld | Agentes ativos no fim: %d\n", (long long)collisionMetrics.GetTotalContacts(),
+           agentManager.GetActiveAgentCount());
+    if (captures > 0) {
+        printf("Checkpoints: %d capturados (%.2f ms cada) | %llu gravados em %s\n", captures,
+               captureSeconds * 1000.0 / captures, (unsigned long long)checkpointWriter.GetWrittenCount(),
+               options.checkpoint.c_str());
+    }
+    if (commandLog) {
+        uint64_t records = commandLog->GetRecordCount();
+        uint64_t bytes = commandLog->GetBytesWritten();
+        printf("Log de comandos: %llu registros | %.1f MB em %u arquivo(s) | %.1f bytes/registro | "
+               "%llu esperas com a fila cheia%s\n", (unsigned long long)records, bytes / (1024.0 * 1024.0),
+               commandLog->GetFileCount(), records > 0 ? (double)bytes / records : 0.0,
+               (unsigned long long)commandLog->GetStallCount(), commandLog->Failed() ? " | FALHA NA ESCRITA" : "");
+        commandLog.reset();
+    }
+    if (!options.metrics.empty()) {
+        Metrics::Flush();
+        size_t searches = Metrics::GetRecords().size();
+        Metrics::SaveToCSV(options.metrics);
+        printf("Métricas: %zu buscas de caminho em %s", searches, options.metrics.c_str());
+        uint64_t dropped = Metrics::GetDroppedCount();
+        if (dropped > 0) printf(" (%llu descartadas)", (unsigned long long)dropped);
+        printf("\n");
+    }
+    
+    ThreadPool::DestroyInstance();
+    return 0;
+}
+
+bool ParseHeadlessOptions(int argc, char** argv, HeadlessOptions& options) {
+    bool headless = false;
+    for (int i = 1; i < argc; i += 2) {
+        const char* flag = argv[i];
+        if (i + 1 == argc) {
+            fprintf(stderr, "Falta o valor de %s\n", flag);
+            options.valid = false;
+            return false;
+        }
+        const char* value = argv[i + 1];
+        if (strcmp(flag, "--ticks") == 0) {
+            options.ticks = strtoull(value, nullptr, 10);
+            headless = true;
+        } else if (strcmp(flag, "--agents") == 0) {
+            options.agents = atoi(value);
+        } else if (strcmp(flag, "--width") == 0) {
+            options.width = atoi(value);
+        } else if (strcmp(flag, "--height") == 0) {
+            options.height = atoi(value);
+        } else if (strcmp(flag, "--map") == 0) {
+            options.map = value;
+        } else if (strcmp(flag, "--seed") == 0) {
+            options.seed = strtoull(value, nullptr, 10);
+        } else if (strcmp(flag, "--threads") == 0) {
+            options.threads = atoi(value);
+        } else if (strcmp(flag, "--steering") == 0) {
+            options.steering = atoi(value) != 0;
+        } else if (strcmp(flag, "--checkpoint") == 0) {
+            options.checkpoint = value;
+        } else if (strcmp(flag, "--checkpoint-every") == 0) {
+            options.checkpointEvery = strtoull(value, nullptr, 10);
+        } else if (strcmp(flag, "--restore") == 0) {
+            options.restore = value;
+        } else if (strcmp(flag, "--command-log") == 0) {
+            options.commandLog = value;
+        } else if (strcmp(flag, "--metrics") == 0) {
+            options.metrics = value;
+        } else {
+            fprintf(stderr, "Opção desconhecida: %s\n", flag);
+        }
+    }
+    return headless;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class ProceduralObstacleFactory;
+
+struct HeadlessOptions {
+    uint64_t ticks = 0;
+    int agents = 1000;
+    int width = 128;
+    int height = 128;
+    std::string map = "city";
+    uint64_t seed = 1;
+    int threads = 0;
+    bool steering = false;
+    // Arquivo de checkpoint, gravado a cada checkpointEvery passos (0 = só no fim).
+    std::string checkpoint;
+    uint64_t checkpointEvery = 0;
+    // Snapshot de onde continuar; substitui grid, mapa, seed e agentes das outras opções.
+    std::string restore;
+    // Base dos arquivos do log de comandos (ver CommandLog); vazio desliga.
+    std::string commandLog;
+    // CSV das métricas de pathfinding (ver Metrics), gravado no fim; vazio desliga.
+    std::string metrics;
+    // false se algum argumento ficou sem valor (ParseHeadlessOptions já avisou).
+    bool valid = true;
+};
+
+// Nome do gerador procedural ("noise", "maze", "rooms", "city"); nullptr para "none".
+std::unique_ptr<ProceduralObstacleFactory> CreateMapGenerator(const std::string& name, uint64_t seed);
+
+// Uso: [--ticks N [--agents N] [--width W] [--height H]
+//       [--map none|noise|maze|rooms|city] [--seed S] [--threads T] [--steering 0|1]
+//       [--checkpoint ARQUIVO [--checkpoint-every N]] [--restore ARQUIVO] [--command-log BASE]
+//       [--metrics ARQUIVO]]
+// Retorna true se --ticks foi passado, isto é, se a simulação deve rodar sem janela. Uma
+// opção sem valor no fim é erro: retorna false com options.valid = false.
+bool ParseHeadlessOptions(int argc, char** argv, HeadlessOptions& options);
+
+// Modo sem janela: monta o cenário, roda `ticks` passos fixos o mais rápido possível e
+// imprime um resumo. Não depende de janela nem de desenho.
+int RunHeadless(const HeadlessOptions& options);
@@ -0,0 +1,9 @@
+#pragma once
+#include <cstdint>
+
+class IStepListener {
+public:
+    virtual ~IStepListener() = default;
+    // Chamado no fim de cada passo da Simulation; `tick` já é o passo seguinte.
+    virtual void OnStep(uint64_t tick) = 0;
+};
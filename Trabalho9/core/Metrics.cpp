@@ -1,25 +1,145 @@
 #include "Metrics.h"
+#include <fstream>
+#include <mutex>
 
-std::vector<MetricData> Metrics::data;
+namespace {
 
-void Metrics::RecordPathfinding(int agents, int gridW, int gridH, 
-                              double time, int pathLen, const std::string& dist) {
-    data.push_back({agents, gridW, gridH, time, pathLen, dist});
+// Protege a lista de buffers, os rótulos e os registros juntados. Quem registra só a pega
+// na primeira vez de cada thread (e na primeira vez de cada rótulo).
+std::mutex metricsMutex;
+std::vector<std::string> labels;
+std::vector<MetricData> merged;
+
+}
+
+std::atomic<int> Metrics::currentAgentCount{0};
+
+Metrics::ThreadBuffer::ThreadBuffer() : tail(new Block), head(tail) {}
+
+std::vector<Metrics::ThreadBuffer*>& Metrics::Buffers() {
+    static std::vector<ThreadBuffer*> buffers;
+    return buffers;
+}
+
+Metrics::ThreadBuffer& Metrics::LocalBuffer() {
+    thread_local ThreadBuffer* local = nullptr;
+    if (!local) {
+        local = new ThreadBuffer;
+        std::lock_guard<std::mutex> lock(metricsMutex);
+        Buffers().push_back(local);
+    }
+    return *local;
+}
+
+uint32_t Metrics::InternLabel(const std::string& label) {
+    thread_local std::vector<std::pair<std::string, uint32_t>> cache;
+    for (const auto& entry : cache) {
+        if (entry.first == label) return entry.second;
+    }
+    
+    uint32_t id;
+    {
+        std::lock_guard<std::mutex> lock(metricsMutex);
+        id = 0;
+        while (id < labels.size() && labels[id] != label) id++;
+        if (id == labels.size()) labels.push_back(label);
+    }
+    cache.push_back({label, id});
+    return id;
+}
+
+std::string Metrics::GetLabel(uint32_t id) {
+    std::lock_guard<std::mutex> lock(metricsMutex);
+    return id < labels.size() ? labels[id] : std::string();
+}
+
+void Metrics::RecordPathfinding(int agents, int gridW, int gridH, double time, int pathLen, uint32_t label) {
+    ThreadBuffer& buffer = LocalBuffer();
+    if (buffer.written - buffer.consumed.load(std::memory_order_relaxed) >= MAX_PENDING_PER_THREAD) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    
+    Block* block = buffer.tail;
+    int count = block->count.load(std::memory_order_relaxed);
+    if (count == BLOCK_RECORDS) {
+        Block* next = new Block;
+        block->next.store(next, std::memory_order_release);
+        buffer.tail = block = next;
+        count = 0;
+    }
+    block->records[count] = {agents, gridW, gridH, pathLen, time, label};
+    block->count.store(count + 1, std::memory_order_release);
+    buffer.written++;
+}
+
+// Um bloco só é liberado depois que a thread dona passou para o seguinte: dali em diante
+// ela não volta a tocá-lo.
+void Metrics::Drain(ThreadBuffer& buffer, std::vector<MetricData>* out) {
+    while (true) {
+        Block* block = buffer.head;
+        int count = block->count.load(std::memory_order_acquire);
+        if (out) out->insert(out->end(), block->records + buffer.readInHead, block->records + count);
+        buffer.consumed.fetch_add(count - buffer.readInHead, std::memory_order_relaxed);
+        buffer.readInHead = count;
+        
+        if (count < BLOCK_RECORDS) break;
+        Block* next = block->next.load(std::memory_order_acquire);
+        if (!next) break;
+        delete block;
+        buffer.head = next;
+        buffer.readInHead = 0;
+    }
+}
+
+void Metrics::DrainAll(std::vector<MetricData>* out) {
+    for (ThreadBuffer* buffer : Buffers()) {
+        Drain(*buffer, out);
+    }
+}
+
+void Metrics::Flush() {
+    std::lock_guard<std::mutex> lock(metricsMutex);
+    DrainAll(&merged);
+}
+
+std::vector<MetricData> Metrics::GetRecords() {
+    std::lock_guard<std::mutex> lock(metricsMutex);
+    return merged;
+}
+
+uint64_t Metrics::GetDroppedCount() {
+    std::lock_guard<std::mutex> lock(metricsMutex);
+    uint64_t dropped = 0;
+    for (ThreadBuffer* buffer : Buffers()) {
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
 }
 
 void Metrics::SaveToCSV(const std::string& filename) {
+    std::lock_guard<std::mutex> lock(metricsMutex);
+    DrainAll(&merged);
+    
     std::ofstream file(filename);
     file << "agents,grid_width,grid_height,time_ms,path_length,distribution\n";
     
-    for (const auto& metric : data) {
+    for (const auto& metric : merged) {
         file << metric.agentCount << ","
              << metric.gridWidth << ","
              << metric.gridHeight << ","
              << metric.pathfindingTime * 1000 << ","
              << metric.pathLength << ","
-             << metric.distributionType << "\n";
+             << (metric.distributionLabel < labels.size() ? labels[metric.distributionLabel] : "") << "\n";
     }
     file.close();
 }
 
-void Metrics::Clear() { data.clear(); }
\ No newline at end of file
+void Metrics::Clear() {
+    std::lock_guard<std::mutex> lock(metricsMutex);
+    DrainAll(nullptr);
+    merged.clear();
+    for (ThreadBuffer* buffer : Buffers()) {
+        buffer->dropped.store(0, std::memory_order_relaxed);
+    }
+}
@@ -1,24 +1,83 @@
 #pragma once
-#include <vector>
+#include <atomic>
+#include <cstdint>
 #include <string>
-#include <fstream>
+#include <vector>
 
+// Registro de uma busca de caminho. POD: o rótulo da distribuição é um id de
+// Metrics::InternLabel, não uma string.
 struct MetricData {
-    int agentCount;
-    int gridWidth;
-    int gridHeight;
+    int32_t agentCount;
+    int32_t gridWidth;
+    int32_t gridHeight;
+    int32_t pathLength;
     double pathfindingTime;
-    int pathLength;
-    std::string distributionType;
+    uint32_t distributionLabel;
 };
 
+// Métricas de pathfinding, registradas de qualquer thread (as buscas rodam nos workers
+// do ThreadPool). Cada thread escreve no próprio buffer, uma lista de blocos de tamanho
+// fixo, sem trava: o registro é uma cópia no bloco atual mais uma publicação atômica do
+// contador. Flush, chamado por quem vai ler, junta os registros de todas as threads numa
+// lista única e libera os blocos já lidos. Por thread ficam no máximo
+// MAX_PENDING_PER_THREAD registros não juntados; os que passarem disso são descartados e
+// contados em GetDroppedCount.
 class Metrics {
+public:
+    static constexpr int BLOCK_RECORDS = 4096;
+    static constexpr uint64_t MAX_PENDING_PER_THREAD = 1 << 20;
+
 private:
-    static std::vector<MetricData> data;
-    
+    struct Block {
+        MetricData records[BLOCK_RECORDS];
+        std::atomic<int> count{0};
+        std::atomic<Block*> next{nullptr};
+    };
+
+    struct ThreadBuffer {
+        // Lado da thread dona.
+        Block* tail;
+        uint64_t written = 0;
+        std::atomic<uint64_t> dropped{0};
+        // Lado de Flush.
+        Block* head;
+        int readInHead = 0;
+        std::atomic<uint64_t> consumed{0};
+
+        ThreadBuffer();
+    };
+
+    static std::atomic<int> currentAgentCount;
+
+    // Buffers de todas as threads que já registraram. Nunca são liberados: uma thread que
+    // terminou ainda pode ter registros para juntar.
+    static std::vector<ThreadBuffer*>& Buffers();
+    static ThreadBuffer& LocalBuffer();
+    // Chamadas com a trava das métricas.
+    static void Drain(ThreadBuffer& buffer, std::vector<MetricData>* out);
+    static void DrainAll(std::vector<MetricData>* out);
+
 public:
-    static void RecordPathfinding(int agents, int gridW, int gridH, 
-                                double time, int pathLen, const std::string& dist);
+    // Id estável para `label`; a mesma string sempre dá o mesmo id. Cada thread guarda os
+    // ids que já usou, então rótulos repetidos não passam pela tabela global.
+    static uint32_t InternLabel(const std::string& label);
+    static std::string GetLabel(uint32_t id);
+
+    // Quantos agentes a simulação tem agora; entra nos registros de pathfinding.
+    static void SetAgentCount(int count) { currentAgentCount.store(count, std::memory_order_relaxed); }
+    static int GetAgentCount() { return currentAgentCount.load(std::memory_order_relaxed); }
+
+    static void RecordPathfinding(int agents, int gridW, int gridH, double time, int pathLen, uint32_t label);
+    static void RecordPathfinding(int agents, int gridW, int gridH, double time, int pathLen, const std::string& dist) {
+        RecordPathfinding(agents, gridW, gridH, time, pathLen, InternLabel(dist));
+    }
+
+    // Junta os buffers das threads na lista de registros. Pode rodar junto com registros
+    // sendo feitos; os que chegarem depois ficam para o próximo Flush.
+    static void Flush();
+    // Cópia dos registros juntados até o último Flush.
+    static std::vector<MetricData> GetRecords();
+    static uint64_t GetDroppedCount();
     static void SaveToCSV(const std::string& filename);
     static void Clear();
-};
\ No newline at end of file
+};
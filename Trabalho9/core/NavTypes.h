@@ -0,0 +1,38 @@
+#pragma once
+
+// Tipos básicos da navcore. Sem NAV_USE_RAYLIB, Vector2 e Color são definidos aqui com o
+// mesmo layout (e a mesma definição) dos tipos do raylib, então a biblioteca compila e
+// linka sem ele. O front end define NAV_USE_RAYLIB e usa os tipos do próprio raylib.h.
+#if defined(NAV_USE_RAYLIB)
+#include "raylib.h"
+#else
+
+#if !defined(RL_VECTOR2_TYPE)
+typedef struct Vector2 {
+    float x;                // Vector x component
+    float y;                // Vector y component
+} Vector2;
+#define RL_VECTOR2_TYPE
+#endif
+
+#if !defined(RL_COLOR_TYPE)
+typedef struct Color {
+    unsigned char r;        // Color red value
+    unsigned char g;        // Color green value
+    unsigned char b;        // Color blue value
+    unsigned char a;        // Color alpha value
+} Color;
+#define RL_COLOR_TYPE
+#endif
+
+#endif
+
+// Paleta dos agentes (mesmos valores das cores do raylib).
+namespace NavColors {
+    constexpr Color Blue = {0, 121, 241, 255};
+    constexpr Color Purple = {200, 122, 255, 255};
+    constexpr Color Orange = {255, 161, 0, 255};
+    constexpr Color Pink = {255, 109, 194, 255};
+    constexpr Color DarkBlue = {0, 82, 172, 255};
+    constexpr Color DarkPurple = {112, 31, 126, 255};
+}
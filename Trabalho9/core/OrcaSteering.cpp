@@ -0,0 +1,227 @@
+#include "OrcaSteering.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr float EPSILON = 1e-5f;
+
+struct Vec2 {
+    float x, y;
+};
+
+inline Vec2 operator+(Vec2 a, Vec2 b) { return {a.x + b.x, a.y + b.y}; }
+inline Vec2 operator-(Vec2 a, Vec2 b) { return {a.x - b.x, a.y - b.y}; }
+inline Vec2 operator*(float s, Vec2 a) { return {s * a.x, s * a.y}; }
+inline float Dot(Vec2 a, Vec2 b) { return a.x * b.x + a.y * b.y; }
+inline float Det(Vec2 a, Vec2 b) { return a.x * b.y - a.y * b.x; }
+inline float LengthSq(Vec2 a) { return Dot(a, a); }
+
+inline Vec2 Normalize(Vec2 a) {
+    float length = std::sqrt(LengthSq(a));
+    return length > 0.0f ? (1.0f / length) * a : Vec2{0.0f, 0.0f};
+}
+
+// Semiplano de velocidades permitidas: tudo à esquerda de `direction` passando por `point`.
+struct Line {
+    Vec2 point;
+    Vec2 direction;
+};
+
+// Otimiza sobre a reta `lineNo`, respeitando as retas anteriores e o círculo de raio
+// `radius`. Retorna false se o intervalo viável na reta ficar vazio.
+bool LinearProgram1(const Line* lines, int lineNo, float radius, Vec2 optVelocity, bool directionOpt, Vec2& result) {
+    const Line& line = lines[lineNo];
+    const float dot = Dot(line.point, line.direction);
+    const float discriminant = dot * dot + radius * radius - LengthSq(line.point);
+    if (discriminant < 0.0f) return false;
+
+    const float sqrtDiscriminant = std::sqrt(discriminant);
+    float tLeft = -dot - sqrtDiscriminant;
+    float tRight = -dot + sqrtDiscriminant;
+
+    for (int i = 0; i < lineNo; i++) {
+        const float denominator = Det(line.direction, lines[i].direction);
+        const float numerator = Det(lines[i].direction, line.point - lines[i].point);
+        if (std::fabs(denominator) <= EPSILON) {
+            // Retas paralelas: ou a anterior contém esta inteira, ou não há solução.
+            if (numerator < 0.0f) return false;
+            continue;
+        }
+        const float t = numerator / denominator;
+        if (denominator >= 0.0f) {
+            tRight = std::min(tRight, t);
+        } else {
+            tLeft = std::max(tLeft, t);
+        }
+        if (tLeft > tRight) return false;
+    }
+
+    if (directionOpt) {
+        result = line.point + (Dot(optVelocity, line.direction) > 0.0f ? tRight : tLeft) * line.direction;
+    } else {
+        const float t = std::clamp(Dot(line.direction, optVelocity - line.point), tLeft, tRight);
+        result = line.point + t * line.direction;
+    }
+    return true;
+}
+
+// Programa linear incremental sobre todas as retas. Retorna `count` em caso de sucesso ou
+// o índice da primeira reta que não pôde ser satisfeita.
+int LinearProgram2(const Line* lines, int count, float radius, Vec2 optVelocity, bool directionOpt, Vec2& result) {
+    if (directionOpt) {
+        result = radius * optVelocity;
+    } else if (LengthSq(optVelocity) > radius * radius) {
+        result = radius * Normalize(optVelocity);
+    } else {
+        result = optVelocity;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (Det(lines[i].direction, lines[i].point - result) > 0.0f) {
+            const Vec2 previous = result;
+            if (!LinearProgram1(lines, i, radius, optVelocity, directionOpt, result)) {
+                result = previous;
+                return i;
+            }
+        }
+    }
+    return count;
+}
+
+// Sem solução viável (multidão muito densa): minimiza a maior violação entre as retas,
+// a partir da primeira que falhou.
+void LinearProgram3(const Line* lines, int count, int beginLine, float radius, Vec2& result, Line* projected) {
+    float distance = 0.0f;
+    for (int i = beginLine; i < count; i++) {
+        if (Det(lines[i].direction, lines[i].point - result) <= distance) continue;
+
+        int projectedCount = 0;
+        for (int j = 0; j < i; j++) {
+            Line line;
+            const float determinant = Det(lines[i].direction, lines[j].direction);
+            if (std::fabs(determinant) <= EPSILON) {
+                if (Dot(lines[i].direction, lines[j].direction) > 0.0f) continue;
+                line.point = 0.5f * (lines[i].point + lines[j].point);
+            } else {
+                line.point = lines[i].point +
+                             (Det(lines[j].direction, lines[i].point - lines[j].point) / determinant) * lines[i].direction;
+            }
+            line.direction = Normalize(lines[j].direction - lines[i].direction);
+            projected[projectedCount++] = line;
+        }
+
+        const Vec2 previous = result;
+        const Vec2 optDirection = {-lines[i].direction.y, lines[i].direction.x};
+        if (LinearProgram2(projected, projectedCount, radius, optDirection, true, result) < projectedCount) {
+            // Só falha por erro numérico; fica com o resultado anterior.
+            result = previous;
+        }
+        distance = Det(lines[i].direction, lines[i].point - result);
+    }
+}
+
+// Dados de um lote de vizinhos em estrutura de arrays, montados antes de gerar as retas.
+struct NeighborBatch {
+    int sorted[OrcaSteering::MAX_NEIGHBORS];
+    float distanceSq[OrcaSteering::MAX_NEIGHBORS];
+    float relativeX[OrcaSteering::MAX_NEIGHBORS];
+    float relativeY[OrcaSteering::MAX_NEIGHBORS];
+    float relativeVX[OrcaSteering::MAX_NEIGHBORS];
+    float relativeVY[OrcaSteering::MAX_NEIGHBORS];
+    float combinedRadius[OrcaSteering::MAX_NEIGHBORS];
+    bool lowerIndex[OrcaSteering::MAX_NEIGHBORS];
+    Line lines[OrcaSteering::MAX_NEIGHBORS];
+    Line projected[OrcaSteering::MAX_NEIGHBORS];
+};
+
+}
+
+void OrcaSteering::SetSettings(const SteeringSettings& newSettings) {
+    settings = newSettings;
+    settings.maxNeighbors = std::clamp(settings.maxNeighbors, 0, MAX_NEIGHBORS);
+    settings.timeHorizon = std::max(settings.timeHorizon, EPSILON);
+}
+
+Vector2 OrcaSteering::ComputeVelocity(const AgentStorage& agents, const SpatialHash& neighbors, int index,
+                                      Vector2 preferredVelocity, float timeStep) const {
+    static thread_local NeighborBatch batch;
+
+    const float x = agents.positionX[index];
+    const float y = agents.positionY[index];
+    const Vec2 velocity = {agents.velocityX[index], agents.velocityY[index]};
+    const float radius = agents.collRadius[index];
+    const AgentHandle self = agents.handle[index];
+
+    const int count = neighbors.QueryNeighbors(x, y, settings.neighborDistance, self, settings.maxNeighbors,
+                                               batch.sorted, batch.distanceSq);
+
+    int valid = 0;
+    for (int n = 0; n < count; n++) {
+        const AgentHandle other = neighbors.GetSortedHandle(batch.sorted[n]);
+        const int otherIndex = agents.DenseIndex(other);
+        if (otherIndex < 0) continue;
+        batch.relativeX[valid] = agents.positionX[otherIndex] - x;
+        batch.relativeY[valid] = agents.positionY[otherIndex] - y;
+        batch.relativeVX[valid] = velocity.x - agents.velocityX[otherIndex];
+        batch.relativeVY[valid] = velocity.y - agents.velocityY[otherIndex];
+        batch.combinedRadius[valid] = radius + agents.collRadius[otherIndex];
+        batch.lowerIndex[valid] = self.index < other.index;
+        valid++;
+    }
+
+    const float invTimeHorizon = 1.0f / settings.timeHorizon;
+    const float invTimeStep = 1.0f / timeStep;
+    for (int n = 0; n < valid; n++) {
+        const Vec2 relativePosition = {batch.relativeX[n], batch.relativeY[n]};
+        const Vec2 relativeVelocity = {batch.relativeVX[n], batch.relativeVY[n]};
+        const float distSq = LengthSq(relativePosition);
+        const float combinedRadius = batch.combinedRadius[n];
+        const float combinedRadiusSq = combinedRadius * combinedRadius;
+
+        Line& line = batch.lines[n];
+        Vec2 u;
+        if (distSq > combinedRadiusSq) {
+            // Sem colisão: projeta no cone truncado pelo horizonte de tempo.
+            const Vec2 w = relativeVelocity - invTimeHorizon * relativePosition;
+            const float wLengthSq = LengthSq(w);
+            const float dot = Dot(w, relativePosition);
+            if (dot < 0.0f && dot * dot > combinedRadiusSq * wLengthSq) {
+                const float wLength = std::sqrt(wLengthSq);
+                const Vec2 unitW = (1.0f / wLength) * w;
+                line.direction = {unitW.y, -unitW.x};
+                u = (combinedRadius * invTimeHorizon - wLength) * unitW;
+            } else {
+                const float leg = std::sqrt(distSq - combinedRadiusSq);
+                if (Det(relativePosition, w) > 0.0f) {
+                    line.direction = (1.0f / distSq) * Vec2{relativePosition.x * leg - relativePosition.y * combinedRadius,
+                                                            relativePosition.x * combinedRadius + relativePosition.y * leg};
+                } else {
+                    line.direction = (-1.0f / distSq) * Vec2{relativePosition.x * leg + relativePosition.y * combinedRadius,
+                                                             -relativePosition.x * combinedRadius + relativePosition.y * leg};
+                }
+                u = Dot(relativeVelocity, line.direction) * line.direction - relativeVelocity;
+            }
+        } else {
+            // Já sobrepostos: separa dentro deste passo. Agentes exatamente no mesmo ponto
+            // se afastam em sentidos opostos, decididos pelo índice do slot.
+            const Vec2 w = relativeVelocity - invTimeStep * relativePosition;
+            const float wLength = std::sqrt(LengthSq(w));
+            const Vec2 unitW = wLength > EPSILON ? (1.0f / wLength) * w
+                                                 : Vec2{batch.lowerIndex[n] ? -1.0f : 1.0f, 0.0f};
+            line.direction = {unitW.y, -unitW.x};
+            u = (combinedRadius * invTimeStep - wLength) * unitW;
+        }
+        // Os dois agentes desviam, cada um assume metade da correção (reciprocidade).
+        line.point = velocity + 0.5f * u;
+    }
+
+    const Vec2 preferred = {preferredVelocity.x, preferredVelocity.y};
+    const float maxSpeed = std::sqrt(LengthSq(preferred));
+    Vec2 result;
+    const int failed = LinearProgram2(batch.lines, valid, maxSpeed, preferred, false, result);
+    if (failed < valid) {
+        LinearProgram3(batch.lines, valid, failed, maxSpeed, result, batch.projected);
+    }
+    return {result.x, result.y};
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "NavTypes.h"
+#include "AgentStorage.h"
+#include "SpatialHash.h"
+
+struct SteeringSettings {
+    float neighborDistance = 45.0f;  // raio de busca de vizinhos, em pixels
+    int maxNeighbors = 10;           // limita o custo por agente em multidões densas
+    float timeHorizon = 1.0f;        // segundos à frente em que colisões são evitadas
+};
+
+// Evitação local por obstáculos de velocidade recíprocos (ORCA). Cada vizinho próximo vira
+// um semiplano de velocidades permitidas; um programa linear 2D acha a velocidade mais
+// próxima da preferida dentro de todos eles e do círculo de velocidade máxima. Os
+// vizinhos vêm da grade uniforme, então o custo por agente é O(maxNeighbors) e não há
+// trabalho O(n²).
+//
+// Só agentes acordados entram na grade de vizinhos: os que dormem (ver AgentState) estão
+// parados no alvo e, como obstáculos, bloqueariam as células do caminho de quem passa.
+//
+// ComputeVelocity só lê AgentStorage e a grade (velocidades do passo anterior), então
+// pode rodar para vários agentes em paralelo.
+class OrcaSteering {
+private:
+    SteeringSettings settings;
+
+public:
+    // Limite de maxNeighbors aceito; os buffers por thread são dimensionados por ele.
+    static constexpr int MAX_NEIGHBORS = 64;
+
+    const SteeringSettings& GetSettings() const { return settings; }
+    void SetSettings(const SteeringSettings& newSettings);
+
+    // Velocidade (pixels/s) para o agente denso `index`, com módulo até o da preferida.
+    // `neighbors` deve ter sido construída com as posições atuais dos agentes ativos.
+    Vector2 ComputeVelocity(const AgentStorage& agents, const SpatialHash& neighbors, int index,
+                            Vector2 preferredVelocity, float timeStep) const;
+};
@@ -0,0 +1,31 @@
+#pragma once
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+// Divide [begin, end) em blocos contíguos e chama fn(blocoInicio, blocoFim) em threads.
+// threadCount == 0 usa todos os núcleos. fn não pode depender da ordem dos blocos.
+template <typename Fn>
+void ParallelFor(int begin, int end, Fn&& fn, int threadCount = 0, int minChunk = 16) {
+    int count = end - begin;
+    if (count <= 0) return;
+    
+    int threads = threadCount > 0 ? threadCount : (int)std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, (count + minChunk - 1) / minChunk);
+    
+    if (threads <= 1) {
+        fn(begin, end);
+        return;
+    }
+    
+    int chunk = (count + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (int start = begin + chunk; start < end; start += chunk) {
+        workers.emplace_back([&fn, start, end, chunk]() { fn(start, std::min(end, start + chunk)); });
+    }
+    fn(begin, std::min(end, begin + chunk));
+    
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
@@ -1,5 +1,5 @@
 #pragma once
-#include "raylib.h"
+#include "NavTypes.h"
 #include "Grid.h"
 #include <vector>
 #include <string>
@@ -7,7 +7,10 @@
 class Pathfinder {
 public:
     virtual ~Pathfinder() = default;
+    // minClearance: clearance mínima (ver Grid::GetClearance) exigida das células do caminho,
+    // usada para agentes com raio maior que meia célula. O destino só precisa ser caminhável.
     virtual std::vector<Vector2> FindPath(Grid& grid, Vector2 start, Vector2 end, 
-                                         const std::string& distribution = "random") = 0;
+                                         const std::string& distribution = "random",
+                                         int minClearance = 0) = 0;
     virtual double GetLastExecutionTime() = 0;
 };
\ No newline at end of file
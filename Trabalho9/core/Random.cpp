@@ -0,0 +1,11 @@
+#include "Random.h"
+
+namespace {
+CounterRandom defaultRandom;
+}
+
+IRandom* Random::source = &defaultRandom;
+
+void Random::SetSource(IRandom* random) {
+    source = random ? random : &defaultRandom;
+}
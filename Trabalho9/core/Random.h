@@ -0,0 +1,86 @@
+#pragma once
+#include "CounterRng.h"
+#include <cstdint>
+#include <utility>
+
+// Estado completo de um gerador: restaurar continua exatamente a mesma sequência.
+struct RandomState {
+    uint64_t seed = 0;
+    uint64_t counter = 0;
+};
+
+class IRandom {
+public:
+    virtual ~IRandom() = default;
+    virtual void Seed(uint64_t seed) = 0;
+    // Inteiro uniforme em [min, max].
+    virtual int Range(int min, int max) = 0;
+    virtual RandomState GetState() const = 0;
+    virtual void SetState(const RandomState& state) = 0;
+};
+
+// Sequência determinística e portátil: o n-ésimo sorteio é CounterRng(seed).RangeAt(n, ...),
+// então o mesmo seed gera os mesmos mapas e agentes em qualquer plataforma.
+class CounterRandom : public IRandom {
+private:
+    CounterRng rng;
+    uint64_t seed;
+    uint64_t counter = 0;
+    
+public:
+    explicit CounterRandom(uint64_t seed = 0) : rng(seed), seed(seed) {}
+    
+    void Seed(uint64_t newSeed) override {
+        rng = CounterRng(newSeed);
+        seed = newSeed;
+        counter = 0;
+    }
+    
+    RandomState GetState() const override { return {seed, counter}; }
+    
+    void SetState(const RandomState& state) override {
+        Seed(state.seed);
+        counter = state.counter;
+    }
+    
+    int Range(int min, int max) override {
+        if (min > max) std::swap(min, max);
+        uint64_t n = counter++;
+        return rng.RangeAt((uint32_t)(n >> 32), (uint32_t)n, min, max);
+    }
+};
+
+// Gerador global da navcore (posições iniciais, alvos, cores, fábricas aleatórias). Não é
+// thread-safe: só deve ser usado fora da fase paralela de UpdateAll.
+class Random {
+private:
+    static IRandom* source;
+    
+public:
+    static void Seed(uint64_t seed) { source->Seed(seed); }
+    static int Range(int min, int max) { return source->Range(min, max); }
+    static RandomState GetState() { return source->GetState(); }
+    static void SetState(const RandomState& state) { source->SetState(state); }
+    // nullptr volta para o CounterRandom padrão. O gerador passado precisa viver enquanto
+    // estiver instalado.
+    static void SetSource(IRandom* random);
+};
+
+// Gerador de quem aceita um seed próprio (fábricas): sem seed sorteia do Random global;
+// com seed tem uma sequência independente, que não muda com o que mais usou o global.
+class SeedableRandom {
+private:
+    CounterRandom local;
+    bool seeded = false;
+    
+public:
+    SeedableRandom() = default;
+    explicit SeedableRandom(uint64_t seed) : local(seed), seeded(true) {}
+    
+    void SetSeed(uint64_t seed) {
+        local.Seed(seed);
+        seeded = true;
+    }
+    
+    int Range(int min, int max) { return seeded ? local.Range(min, max) : Random::Range(min, max); }
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+// Dados temporários de uma busca, indexados por célula (y * width + x).
+// Cada busca incrementa `generation`; uma célula só é considerada visitada quando
+// seu carimbo bate com a geração atual, então nada precisa ser zerado entre buscas.
+// Os pathfinders mantêm uma instância thread_local, sem tocar nos Nodes do Grid.
+struct SearchScratch {
+    std::vector<int> gCost;
+    std::vector<int> parent;
+    std::vector<uint32_t> visited;
+    std::vector<uint32_t> closed;
+    uint32_t generation = 0;
+    
+    void Prepare(int cellCount) {
+        if ((int)visited.size() < cellCount) {
+            gCost.resize(cellCount);
+            parent.resize(cellCount);
+            visited.resize(cellCount, 0);
+            closed.resize(cellCount, 0);
+        }
+        if (++generation == 0) {
+            std::fill(visited.begin(), visited.end(), 0);
+            std::fill(closed.begin(), closed.end(), 0);
+            generation = 1;
+        }
+    }
+    
+    bool IsVisited(int i) const { return visited[i] == generation; }
+    bool IsClosed(int i) const { return closed[i] == generation; }
+    void Close(int i) { closed[i] = generation; }
+    
+    void Visit(int i, int g, int from) {
+        visited[i] = generation;
+        gCost[i] = g;
+        parent[i] = from;
+    }
+};
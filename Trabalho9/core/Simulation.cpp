@@ -0,0 +1,35 @@
+#include "Simulation.h"
+
+Simulation::Simulation(AgentManager& agentManager, double tickRate, int maxStepsPerFrame)
+    : agentManager(&agentManager), fixedDelta(1.0 / tickRate), maxStepsPerFrame(maxStepsPerFrame) {}
+
+void Simulation::Step() {
+    agentManager->UpdateAll((float)fixedDelta, (tick + 1) * fixedDelta);
+    agentManager->CheckCollision();
+    tick++;
+    if (stepListener) stepListener->OnStep(tick);
+}
+
+void Simulation::RunTicks(uint64_t count) {
+    for (uint64_t i = 0; i < count; i++) {
+        Step();
+    }
+}
+
+float Simulation::Advance(double frameTime) {
+    accumulator += frameTime;
+    
+    int steps = 0;
+    // O tempo do passo sai do acumulador antes de rodar: um ouvinte que restaure um
+    // snapshot durante o passo zera o acumulador e o quadro para ali.
+    while (accumulator >= fixedDelta && steps < maxStepsPerFrame) {
+        accumulator -= fixedDelta;
+        Step();
+        steps++;
+    }
+    if (steps == maxStepsPerFrame && accumulator >= fixedDelta) {
+        accumulator = 0.0;
+    }
+    
+    return (float)(accumulator / fixedDelta);
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "AgentManager.h"
+#include "IStepListener.h"
+#include <cstdint>
+
+// Passo fixo da simulação, independente da taxa de quadros. Com janela, Advance acumula o
+// tempo real do quadro, roda quantos passos couberem e devolve a fração que sobrou do
+// próximo passo (alpha) para interpolar o desenho. Sem janela, RunTicks roda passos em
+// sequência o mais rápido que a CPU permitir.
+class Simulation {
+private:
+    AgentManager* agentManager;
+    double fixedDelta;
+    int maxStepsPerFrame;
+    double accumulator = 0.0;
+    uint64_t tick = 0;
+    IStepListener* stepListener = nullptr;
+    
+public:
+    static constexpr double DEFAULT_TICK_RATE = 60.0;
+    
+    // maxStepsPerFrame limita quantos passos um quadro lento pode acumular; o excesso é
+    // descartado, para a simulação não entrar numa espiral de atraso.
+    explicit Simulation(AgentManager& agentManager, double tickRate = DEFAULT_TICK_RATE, int maxStepsPerFrame = 8);
+    
+    void SetAgentManager(AgentManager& manager) { agentManager = &manager; }
+    // Um único ouvinte por vez (a Timeline); nullptr desliga.
+    void SetStepListener(IStepListener* listener) { stepListener = listener; }
+    
+    void Step();
+    void RunTicks(uint64_t count);
+    float Advance(double frameTime);
+    
+    uint64_t GetTick() const { return tick; }
+    // Volta para o passo gravado num snapshot, sem tempo acumulado de quadro.
+    void RestoreTick(uint64_t restoredTick) {
+        tick = restoredTick;
+        accumulator = 0.0;
+    }
+    double GetFixedDelta() const { return fixedDelta; }
+    double GetSimulationTime() const { return tick * fixedDelta; }
+};
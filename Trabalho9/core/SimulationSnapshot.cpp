@@ -0,0 +1,78 @@
+#include "SimulationSnapshot.h"
+#include "Snapshot.h"
+#include "Grid.h"
+#include "Simulation.h"
+#include "AgentManager.h"
+#include "Random.h"
+#include <cstdio>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+void CaptureSnapshot(const Grid& grid, const Simulation& simulation, const AgentManager& agentManager,
+                     std::vector<uint8_t>& out) {
+    out.clear();
+    SnapshotWriter writer(out);
+    writer.Write(SNAPSHOT_MAGIC);
+    writer.Write(SNAPSHOT_VERSION);
+    grid.SaveSnapshot(writer);
+    writer.Write(simulation.GetTick());
+    writer.Write(Random::GetState());
+    agentManager.SaveSnapshot(writer);
+}
+
+bool RestoreSnapshot(const std::vector<uint8_t>& data, Grid& grid, Simulation& simulation,
+                     AgentManager& agentManager) {
+    // Tudo é lido e validado antes de mexer no cenário.
+    SnapshotReader reader(data);
+    uint32_t magic, version;
+    if (!reader.Read(magic) || !reader.Read(version) || magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION) {
+        return false;
+    }
+    Grid::SnapshotData gridData;
+    uint64_t tick;
+    RandomState randomState;
+    AgentManager::SnapshotData agentData;
+    if (!Grid::ReadSnapshot(reader, gridData) || !reader.Read(tick) || !reader.Read(randomState) ||
+        !AgentManager::ReadSnapshot(reader, agentData) || !reader.AtEnd()) {
+        return false;
+    }
+    
+    grid.ApplySnapshot(gridData);
+    agentManager.ApplySnapshot(agentData);
+    simulation.RestoreTick(tick);
+    Random::SetState(randomState);
+    return true;
+}
+
+bool WriteSnapshotFile(const std::string& path, const std::vector<uint8_t>& data) {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+    bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+    // Os dados vão para o disco antes de o arquivo poder ser renomeado por cima de um
+    // checkpoint anterior.
+    ok = ok && fflush(file) == 0;
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(file)) == 0;
+#else
+    ok = ok && fsync(fileno(file)) == 0;
+#endif
+    ok = fclose(file) == 0 && ok;
+    return ok;
+}
+
+bool ReadSnapshotFile(const std::string& path, std::vector<uint8_t>& data) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+    bool ok = fseek(file, 0, SEEK_END) == 0;
+    long size = ok ? ftell(file) : -1;
+    ok = size >= 0 && fseek(file, 0, SEEK_SET) == 0;
+    if (ok) {
+        data.resize((size_t)size);
+        ok = fread(data.data(), 1, data.size(), file) == data.size();
+    }
+    fclose(file);
+    return ok;
+}
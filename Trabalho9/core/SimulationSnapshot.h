@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Grid;
+class Simulation;
+class AgentManager;
+
+// Snapshot binário de uma simulação em andamento: cabeçalho, Grid, passo da Simulation,
+// estado do Random global e AgentManager (agentes, caminhos, comportamentos e comandos
+// pendentes). Restaurar e rodar N passos dá o mesmo resultado, bit a bit, que continuar a
+// execução original por N passos.
+//
+// Capturar é basicamente copiar os arrays SoA para um buffer, então pode ser feito a cada
+// poucos segundos entre dois passos; a escrita em disco fica com o CheckpointWriter, em
+// outra thread.
+constexpr uint32_t SNAPSHOT_MAGIC = 0x5356414E;  // "NAVS"
+constexpr uint32_t SNAPSHOT_VERSION = 2;
+
+// Substitui o conteúdo de `out` (a capacidade é reaproveitada). Não pode ser chamada
+// durante um passo da simulação.
+void CaptureSnapshot(const Grid& grid, const Simulation& simulation, const AgentManager& agentManager,
+                     std::vector<uint8_t>& out);
+
+// Retorna false, sem mudar nada, se o snapshot for de outra versão ou estiver corrompido.
+bool RestoreSnapshot(const std::vector<uint8_t>& data, Grid& grid, Simulation& simulation,
+                     AgentManager& agentManager);
+
+// Grava e faz fsync antes de fechar: quem renomeia o arquivo depois (CheckpointWriter)
+// nunca deixa um arquivo vazio ou pela metade com o nome final.
+bool WriteSnapshotFile(const std::string& path, const std::vector<uint8_t>& data);
+bool ReadSnapshotFile(const std::string& path, std::vector<uint8_t>& data);
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Serialização binária usada pelos snapshots (ver SimulationSnapshot). Os valores são
+// copiados byte a byte, na ordem de bytes da máquina: o arquivo só é lido de volta na
+// mesma plataforma que o gravou. Arrays SoA inteiros viram um tamanho mais um memcpy.
+class SnapshotWriter {
+private:
+    std::vector<uint8_t>& out;
+
+public:
+    // Acrescenta ao fim de `out`; limpar o vetor antes reaproveita a capacidade.
+    explicit SnapshotWriter(std::vector<uint8_t>& out) : out(out) {}
+
+    void WriteBytes(const void* data, size_t size) {
+        if (size == 0) return;
+        size_t offset = out.size();
+        out.resize(offset + size);
+        std::memcpy(out.data() + offset, data, size);
+    }
+
+    template<class T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Write só aceita tipos copiáveis byte a byte");
+        WriteBytes(&value, sizeof(T));
+    }
+
+    template<class T>
+    void WriteVector(const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable<T>::value, "WriteVector só aceita tipos copiáveis byte a byte");
+        Write<uint64_t>(values.size());
+        WriteBytes(values.data(), values.size() * sizeof(T));
+    }
+};
+
+// Leitura com verificação de limites: qualquer leitura além do fim falha, e depois da
+// primeira falha todas as seguintes também falham (Failed() fica true).
+class SnapshotReader {
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t offset = 0;
+    bool failed = false;
+
+public:
+    explicit SnapshotReader(const std::vector<uint8_t>& bytes) : data(bytes.data()), size(bytes.size()) {}
+
+    bool ReadBytes(void* destination, size_t count) {
+        if (failed || count > size - offset) {
+            failed = true;
+            return false;
+        }
+        if (count > 0) std::memcpy(destination, data + offset, count);
+        offset += count;
+        return true;
+    }
+
+    template<class T>
+    bool Read(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Read só aceita tipos copiáveis byte a byte");
+        return ReadBytes(&value, sizeof(T));
+    }
+
+    template<class T>
+    bool ReadVector(std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable<T>::value, "ReadVector só aceita tipos copiáveis byte a byte");
+        uint64_t count = 0;
+        if (!Read(count)) return false;
+        if (count > (size - offset) / sizeof(T)) {
+            failed = true;
+            return false;
+        }
+        values.resize((size_t)count);
+        return ReadBytes(values.data(), (size_t)count * sizeof(T));
+    }
+
+    // Marca o snapshot como inválido (dados lidos com sucesso, mas inconsistentes).
+    bool Fail() {
+        failed = true;
+        return false;
+    }
+
+    bool Failed() const { return failed; }
+    bool AtEnd() const { return offset == size; }
+};
@@ -0,0 +1,171 @@
+#include "SpatialHash.h"
+#include "ThreadPool.h"
+#include "CollisionKernels.h"
+#include <algorithm>
+#include <cmath>
+
+void SpatialHash::Build(const float* x, const float* y, const float* broadRadius, const float* collRadius,
+                        const AgentHandle* handles, int count, float worldWidth, float worldHeight) {
+    float maxBroad = 0.0f;
+    for (int i = 0; i < count; i++) {
+        maxBroad = std::max(maxBroad, broadRadius[i]);
+    }
+    cellSize = std::max(2.0f * maxBroad, 1.0f);
+    columns = std::max(1, (int)(worldWidth / cellSize) + 1);
+    rows = std::max(1, (int)(worldHeight / cellSize) + 1);
+
+    const int cellCount = columns * rows;
+    cellStart.assign(cellCount + 1, 0);
+    agentCell.resize(count);
+
+    // Agentes fora do mundo vão para a célula da borda mais próxima; a projeção não
+    // aproxima pontos distantes, então pares reais continuam em células vizinhas.
+    for (int i = 0; i < count; i++) {
+        int column = std::clamp((int)(x[i] / cellSize), 0, columns - 1);
+        int row = std::clamp((int)(y[i] / cellSize), 0, rows - 1);
+        int cell = row * columns + column;
+        agentCell[i] = cell;
+        cellStart[cell + 1]++;
+    }
+
+    for (int cell = 0; cell < cellCount; cell++) {
+        cellStart[cell + 1] += cellStart[cell];
+    }
+
+    sortedHandle.resize(count);
+    sortedX.resize(count);
+    sortedY.resize(count);
+    sortedBroad.resize(count);
+    sortedColl.resize(count);
+
+    // Espalha usando cellStart como cursor e depois desfaz o deslocamento. Como i cresce,
+    // cada célula fica com seus agentes em ordem de índice denso.
+    for (int i = 0; i < count; i++) {
+        int slot = cellStart[agentCell[i]]++;
+        sortedHandle[slot] = handles[i];
+        sortedX[slot] = x[i];
+        sortedY[slot] = y[i];
+        sortedBroad[slot] = broadRadius[i];
+        sortedColl[slot] = collRadius[i];
+    }
+    for (int cell = cellCount; cell > 0; cell--) {
+        cellStart[cell] = cellStart[cell - 1];
+    }
+    cellStart[0] = 0;
+}
+
+// O agente a é testado contra o bloco contíguo [begin, end) de uma vez pelo kernel
+// vetorial; os acertos chegam compactados e só eles viram pares.
+void SpatialHash::TestRange(int a, int begin, int end, std::vector<CollisionEvent>& out) const {
+    const int count = end - begin;
+    if (count <= 0) return;
+
+    static thread_local std::vector<int> hitIndex;
+    static thread_local std::vector<int> hitCollides;
+    if ((int)hitIndex.size() < count + CollisionKernels::PADDING) {
+        hitIndex.resize(count + CollisionKernels::PADDING);
+        hitCollides.resize(count + CollisionKernels::PADDING);
+    }
+
+    const int hits = narrowphase(sortedX[a], sortedY[a], sortedBroad[a], sortedColl[a],
+                                 sortedX.data() + begin, sortedY.data() + begin,
+                                 sortedBroad.data() + begin, sortedColl.data() + begin,
+                                 count, hitIndex.data(), hitCollides.data());
+
+    const AgentHandle first = sortedHandle[a];
+    for (int h = 0; h < hits; h++) {
+        const int b = begin + hitIndex[h];
+        const AgentHandle second = sortedHandle[b];
+        const float dx = sortedX[a] - sortedX[b];
+        const float dy = sortedY[a] - sortedY[b];
+        const float distance = std::sqrt(dx * dx + dy * dy);
+        const bool firstIsLower = first.index < second.index;
+        const AgentHandle agentA = firstIsLower ? first : second;
+        const AgentHandle agentB = firstIsLower ? second : first;
+        
+        out.push_back({agentA, agentB, sortedBroad[a] + sortedBroad[b] - distance, CollisionKind::Broad});
+        if (hitCollides[h]) {
+            out.push_back({agentA, agentB, sortedColl[a] + sortedColl[b] - distance, CollisionKind::Contact});
+        }
+    }
+}
+
+// Células vizinhas na mesma linha são contíguas nos arrays ordenados, então a meia
+// vizinhança de uma célula (ela mesma e a leste; sudoeste, sul e sudeste) vira só dois
+// intervalos contíguos por agente, e cada par de células vizinhas é visitado uma vez.
+void SpatialHash::TestCell(int cell, std::vector<CollisionEvent>& out) const {
+    const int column = cell % columns;
+    const int row = cell / columns;
+    const bool hasEast = column + 1 < columns;
+    const bool hasWest = column > 0;
+
+    const int sameRowEnd = cellStart[cell + (hasEast ? 2 : 1)];
+    int nextRowBegin = 0, nextRowEnd = 0;
+    if (row + 1 < rows) {
+        nextRowBegin = cellStart[cell + columns - (hasWest ? 1 : 0)];
+        nextRowEnd = cellStart[cell + columns + (hasEast ? 2 : 1)];
+    }
+
+    for (int a = cellStart[cell]; a < cellStart[cell + 1]; a++) {
+        TestRange(a, a + 1, sameRowEnd, out);
+        TestRange(a, nextRowBegin, nextRowEnd, out);
+    }
+}
+
+void SpatialHash::FindPairs(CollisionEventStream& stream) {
+    const int cellCount = columns * rows;
+    const int chunkCount = ThreadPool::ChunkCount(cellCount, QUERY_CHUNK);
+    if ((int)chunkEvents.size() < chunkCount) {
+        chunkEvents.resize(chunkCount);
+    }
+
+    ThreadPool::GetInstance().ParallelFor(cellCount, QUERY_CHUNK, [&](int begin, int end, int chunk) {
+        std::vector<CollisionEvent>& out = chunkEvents[chunk];
+        out.clear();
+        for (int cell = begin; cell < end; cell++) {
+            if (cellStart[cell] == cellStart[cell + 1]) continue;
+            TestCell(cell, out);
+        }
+    });
+
+    for (int chunk = 0; chunk < chunkCount; chunk++) {
+        stream.Publish(chunkEvents[chunk].data(), (int)chunkEvents[chunk].size());
+    }
+}
+
+// Percorre as linhas de células que cobrem o círculo de busca; em cada linha as células
+// são contíguas nos arrays ordenados, então o teste de distância roda sobre um intervalo
+// linear. Os mais próximos ficam numa lista ordenada por inserção de tamanho maxNeighbors.
+int SpatialHash::QueryNeighbors(float x, float y, float radius, AgentHandle self, int maxNeighbors,
+                                int* outSorted, float* outDistanceSq) const {
+    if (maxNeighbors <= 0 || sortedX.empty()) return 0;
+
+    const float rangeSq = radius * radius;
+    const int firstColumn = std::clamp((int)((x - radius) / cellSize), 0, columns - 1);
+    const int lastColumn = std::clamp((int)((x + radius) / cellSize), 0, columns - 1);
+    const int firstRow = std::clamp((int)((y - radius) / cellSize), 0, rows - 1);
+    const int lastRow = std::clamp((int)((y + radius) / cellSize), 0, rows - 1);
+
+    int found = 0;
+    for (int row = firstRow; row <= lastRow; row++) {
+        const int begin = cellStart[row * columns + firstColumn];
+        const int end = cellStart[row * columns + lastColumn + 1];
+        for (int i = begin; i < end; i++) {
+            const float dx = sortedX[i] - x;
+            const float dy = sortedY[i] - y;
+            const float distanceSq = dx * dx + dy * dy;
+            if (distanceSq >= rangeSq || sortedHandle[i] == self) continue;
+            if (found == maxNeighbors && distanceSq >= outDistanceSq[found - 1]) continue;
+
+            int slot = found < maxNeighbors ? found++ : found - 1;
+            while (slot > 0 && outDistanceSq[slot - 1] > distanceSq) {
+                outSorted[slot] = outSorted[slot - 1];
+                outDistanceSq[slot] = outDistanceSq[slot - 1];
+                slot--;
+            }
+            outSorted[slot] = i;
+            outDistanceSq[slot] = distanceSq;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "CollisionKernels.h"
+#include "CollisionEventStream.h"
+#include <vector>
+
+// Broadphase em grade uniforme. As células têm o tamanho do maior par de raios amplos
+// (2 * maior broadRadius), então qualquer par que se toca está na mesma célula ou numa
+// vizinha. A grade é reconstruída a cada quadro com counting sort: conta agentes por
+// célula, faz a soma de prefixos e espalha índices e posições em arrays contíguos,
+// ordenados por célula.
+class SpatialHash {
+private:
+    float cellSize = 1.0f;
+    int columns = 0;
+    int rows = 0;
+
+    std::vector<int> agentCell;
+    std::vector<int> cellStart;   // columns * rows + 1 posições
+    std::vector<AgentHandle> sortedHandle;
+    std::vector<float> sortedX;
+    std::vector<float> sortedY;
+    std::vector<float> sortedBroad;
+    std::vector<float> sortedColl;
+
+    std::vector<std::vector<CollisionEvent>> chunkEvents;
+
+    // Kernel de narrowphase escolhido em tempo de execução (AVX2, SSE ou escalar).
+    CollisionKernels::Kernel narrowphase = CollisionKernels::Select();
+
+    void TestRange(int a, int begin, int end, std::vector<CollisionEvent>& out) const;
+    void TestCell(int cell, std::vector<CollisionEvent>& out) const;
+
+public:
+    // Células por bloco na busca paralela de pares.
+    static constexpr int QUERY_CHUNK = 64;
+
+    void Build(const float* x, const float* y, const float* broadRadius, const float* collRadius,
+               const AgentHandle* handles, int count, float worldWidth, float worldHeight);
+
+    // Publica um evento Broad para cada par cujos raios amplos se sobrepõem e, entre esses,
+    // um evento Contact para os que também colidem pelo raio de colisão. Os blocos de
+    // células são publicados na ordem dos blocos, então a sequência de eventos é a mesma
+    // para qualquer número de threads.
+    void FindPairs(CollisionEventStream& stream);
+
+    // Até maxNeighbors agentes mais próximos de (x, y), a menos de `radius`, ignorando
+    // `self`. Grava posições na ordenação interna (ver GetSortedHandle) em ordem crescente
+    // de distância, com as distâncias ao quadrado em outDistanceSq; retorna quantos achou.
+    // Só lê a grade, então pode ser chamada de várias threads ao mesmo tempo.
+    int QueryNeighbors(float x, float y, float radius, AgentHandle self, int maxNeighbors,
+                       int* outSorted, float* outDistanceSq) const;
+    AgentHandle GetSortedHandle(int sorted) const { return sortedHandle[sorted]; }
+
+    void SetNarrowphaseKernel(CollisionKernels::Kernel kernel) { narrowphase = kernel; }
+
+    float GetCellSize() const { return cellSize; }
+    int GetColumns() const { return columns; }
+    int GetRows() const { return rows; }
+};
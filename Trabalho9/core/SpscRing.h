@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Fila circular sem trava para exatamente um produtor e um consumidor (cada um na sua
+// thread). A capacidade é arredondada para potência de dois; os índices só crescem e a
+// posição é o índice mascarado. Cada lado escreve só o próprio índice (release) e lê o do
+// outro (acquire), e cada índice fica na sua linha de cache para os dois lados não
+// disputarem a mesma linha.
+template<class T>
+class SpscRing {
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    std::vector<T> slots;
+    size_t mask;
+
+    alignas(CACHE_LINE) std::atomic<size_t> head{0};  // próximo a consumir
+    alignas(CACHE_LINE) std::atomic<size_t> tail{0};  // próximo a produzir
+
+public:
+    explicit SpscRing(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    size_t Capacity() const { return slots.size(); }
+
+    // Produtor. Retorna false se a fila estiver cheia.
+    bool TryPush(const T& value) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        if (position - head.load(std::memory_order_acquire) == slots.size()) return false;
+        slots[position & mask] = value;
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumidor. Retorna false se a fila estiver vazia.
+    bool TryPop(T& value) {
+        size_t position = head.load(std::memory_order_relaxed);
+        if (position == tail.load(std::memory_order_acquire)) return false;
+        value = slots[position & mask];
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+};
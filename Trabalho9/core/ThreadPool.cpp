@@ -0,0 +1,143 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+std::unique_ptr<ThreadPool> ThreadPool::instance = nullptr;
+
+namespace {
+thread_local bool insidePoolTask = false;
+}
+
+ThreadPool::ThreadPool(int threadCount) {
+    if (threadCount <= 0) {
+        threadCount = (int)std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    for (int i = 0; i < threadCount; i++) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (int i = 1; i < threadCount; i++) {
+        workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::GetInstance() {
+    if (!instance) {
+        instance = std::make_unique<ThreadPool>();
+    }
+    return *instance;
+}
+
+ThreadPool& ThreadPool::CreateInstance(int threadCount) {
+    if (!instance) {
+        instance = std::make_unique<ThreadPool>(threadCount);
+    }
+    return *instance;
+}
+
+void ThreadPool::DestroyInstance() {
+    instance.reset();
+}
+
+bool ThreadPool::TryGetJob(int queueIndex, Job& job) {
+    {
+        WorkerQueue& own = *queues[queueIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = own.jobs.front();
+            own.jobs.pop_front();
+            queued--;
+            return true;
+        }
+    }
+    
+    int queueCount = (int)queues.size();
+    for (int offset = 1; offset < queueCount; offset++) {
+        WorkerQueue& victim = *queues[(queueIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = victim.jobs.back();
+            victim.jobs.pop_back();
+            queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::RunJob(const Job& job) {
+    insidePoolTask = true;
+    (*job.task)(job.begin, job.end, job.chunk);
+    insidePoolTask = false;
+    
+    if (--pending == 0) {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        done.notify_all();
+    }
+}
+
+void ThreadPool::WorkerLoop(int queueIndex) {
+    while (true) {
+        Job job;
+        if (TryGetJob(queueIndex, job)) {
+            RunJob(job);
+            continue;
+        }
+        
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.wait(lock, [this]() { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::ParallelFor(int count, int grain, const RangeTask& task) {
+    if (count <= 0) return;
+    grain = std::max(1, grain);
+    int chunkCount = ChunkCount(count, grain);
+    
+    if (chunkCount == 1 || queues.size() == 1 || insidePoolTask) {
+        for (int chunk = 0; chunk < chunkCount; chunk++) {
+            task(chunk * grain, std::min(count, (chunk + 1) * grain), chunk);
+        }
+        return;
+    }
+    
+    std::lock_guard<std::mutex> submitLock(submitMutex);
+    
+    // Blocos consecutivos vão para a mesma fila, para manter a localidade de memória.
+    int queueCount = (int)queues.size();
+    int perQueue = (chunkCount + queueCount - 1) / queueCount;
+    pending = chunkCount;
+    for (int q = 0; q < queueCount; q++) {
+        std::lock_guard<std::mutex> lock(queues[q]->mutex);
+        for (int chunk = q * perQueue; chunk < std::min(chunkCount, (q + 1) * perQueue); chunk++) {
+            queues[q]->jobs.push_back({&task, chunk * grain, std::min(count, (chunk + 1) * grain), chunk});
+            queued++;
+        }
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+    }
+    wake.notify_all();
+    
+    Job job;
+    while (TryGetJob(0, job)) {
+        RunJob(job);
+    }
+    
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    done.wait(lock, [this]() { return pending.load() == 0; });
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool de threads com roubo de trabalho. ParallelFor divide [0, count) em blocos de
+// tamanho fixo (`grain`); cada thread tem sua fila de blocos, consome a própria pela
+// frente e, quando esvazia, rouba do fim da fila das outras. O índice do bloco é
+// passado para a tarefa, então resultados por bloco podem ser juntados sempre na
+// mesma ordem, independentemente de qual thread executou cada bloco.
+class ThreadPool {
+public:
+    using RangeTask = std::function<void(int begin, int end, int chunk)>;
+    
+private:
+    static std::unique_ptr<ThreadPool> instance;
+    
+    struct Job {
+        const RangeTask* task;
+        int begin;
+        int end;
+        int chunk;
+    };
+    
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+    
+    // queues[0] pertence à thread que chama ParallelFor; queues[i] ao worker i.
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+    
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::atomic<int> queued{0};
+    std::atomic<int> pending{0};
+    bool stopping = false;
+    
+    std::mutex submitMutex;
+    
+    bool TryGetJob(int queueIndex, Job& job);
+    void RunJob(const Job& job);
+    void WorkerLoop(int queueIndex);
+    
+public:
+    explicit ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    static ThreadPool& GetInstance();
+    static ThreadPool& CreateInstance(int threadCount);
+    static void DestroyInstance();
+    
+    int GetThreadCount() const { return (int)queues.size(); }
+    
+    static int ChunkCount(int count, int grain) { return (count + grain - 1) / grain; }
+    
+    // Bloqueia até todos os blocos terminarem. Chamadas feitas de dentro de uma tarefa
+    // rodam em série na thread atual.
+    void ParallelFor(int count, int grain, const RangeTask& task);
+};
@@ -0,0 +1,146 @@
+#include "Timeline.h"
+#include "SimulationSnapshot.h"
+#include "Simulation.h"
+#include "AgentManager.h"
+#include <algorithm>
+
+Timeline::Timeline(Grid& grid, Simulation& simulation, AgentManager& agentManager, int keyframeInterval,
+                   int maxKeyframes)
+    : grid(&grid), simulation(&simulation), agentManager(&agentManager),
+      keyframeInterval(std::max(1, keyframeInterval)), maxKeyframes(std::max(1, maxKeyframes)) {
+    simulation.SetStepListener(this);
+    Reset();
+}
+
+Timeline::~Timeline() {
+    simulation->SetStepListener(nullptr);
+}
+
+void Timeline::CaptureKeyframe(uint64_t tick, bool edited) {
+    // Reaproveita o buffer do keyframe descartado (ou do keyframe substituído no mesmo passo).
+    std::vector<uint8_t> buffer;
+    if (!keyframes.empty() && keyframes.back().tick == tick) {
+        buffer.swap(keyframes.back().snapshot);
+        keyframes.pop_back();
+    } else if ((int)keyframes.size() >= maxKeyframes) {
+        buffer.swap(keyframes.front().snapshot);
+        keyframes.pop_front();
+        uint64_t oldest = keyframes.empty() ? tick : keyframes.front().tick;
+        while (!inputs.empty() && inputs.front().tick < oldest) {
+            inputs.pop_front();
+        }
+    }
+    CaptureSnapshot(*grid, *simulation, *agentManager, buffer);
+    keyframes.push_back({tick, edited, std::move(buffer)});
+}
+
+void Timeline::ApplyInputs(uint64_t tick) {
+    auto it = std::lower_bound(inputs.begin(), inputs.end(), tick,
+                               [](const Input& input, uint64_t value) { return input.tick < value; });
+    for (; it != inputs.end() && it->tick == tick; ++it) {
+        agentManager->AddCommand(it->command);
+    }
+}
+
+void Timeline::TruncateAfter(uint64_t tick) {
+    while (!keyframes.empty() && keyframes.back().tick > tick) {
+        keyframes.pop_back();
+    }
+    while (!inputs.empty() && inputs.back().tick > tick) {
+        inputs.pop_back();
+    }
+}
+
+void Timeline::Reset() {
+    keyframes.clear();
+    inputs.clear();
+    head = simulation->GetTick();
+    CaptureKeyframe(head, false);
+}
+
+void Timeline::Issue(const Command& command) {
+    uint64_t tick = simulation->GetTick();
+    if (tick < head) {
+        TruncateAfter(tick);
+        head = tick;
+    }
+    inputs.push_back({tick, command});
+    agentManager->AddCommand(command);
+}
+
+void Timeline::MarkEdited() {
+    uint64_t tick = simulation->GetTick();
+    TruncateAfter(tick);
+    head = tick;
+    // Os comandos deste passo já estão na fila do AgentManager e entram no keyframe.
+    while (!inputs.empty() && inputs.back().tick == tick) {
+        inputs.pop_back();
+    }
+    CaptureKeyframe(tick, true);
+}
+
+uint64_t Timeline::Seek(uint64_t tick) {
+    uint64_t current = simulation->GetTick();
+    if (keyframes.empty()) return current;
+    tick = std::min(std::max(tick, keyframes.front().tick), head);
+    if (tick == current) return current;
+
+    auto keyframe = std::upper_bound(keyframes.begin(), keyframes.end(), tick,
+                                     [](uint64_t value, const Keyframe& k) { return value < k.tick; });
+    --keyframe;
+    // Para frente dentro do mesmo intervalo entre keyframes, basta continuar rodando.
+    if (tick < current || current < keyframe->tick) {
+        if (!RestoreSnapshot(keyframe->snapshot, *grid, *simulation, *agentManager)) return current;
+        ApplyInputs(keyframe->tick);
+    }
+    while (simulation->GetTick() < tick) {
+        simulation->Step();
+    }
+    return simulation->GetTick();
+}
+
+uint64_t Timeline::StepBack(uint64_t ticks) {
+    uint64_t current = simulation->GetTick();
+    return Seek(current > ticks ? current - ticks : 0);
+}
+
+uint64_t Timeline::StepForward() {
+    simulation->Step();
+    return simulation->GetTick();
+}
+
+uint64_t Timeline::GetOldestTick() const {
+    return keyframes.empty() ? head : keyframes.front().tick;
+}
+
+size_t Timeline::GetMemoryBytes() const {
+    size_t bytes = inputs.size() * sizeof(Input);
+    for (const Keyframe& keyframe : keyframes) {
+        bytes += keyframe.snapshot.capacity();
+    }
+    return bytes;
+}
+
+void Timeline::OnStep(uint64_t tick) {
+    if (tick > head) {
+        head = tick;
+        if (tick % keyframeInterval == 0) CaptureKeyframe(tick, false);
+        return;
+    }
+    // Refazendo passos gravados. Se houve uma edição neste passo, o estado vem do keyframe
+    // dela.
+    for (auto keyframe = keyframes.rbegin(); keyframe != keyframes.rend() && keyframe->tick >= tick; ++keyframe) {
+        if (keyframe->tick == tick && keyframe->edited) {
+            if (!RestoreSnapshot(keyframe->snapshot, *grid, *simulation, *agentManager)) {
+                // Sem o estado da edição, o que foi gravado a partir dela não se repete:
+                // a gravação recomeça daqui, sem a edição.
+                TruncateAfter(tick - 1);
+                head = tick;
+                CaptureKeyframe(tick, false);
+                return;
+            }
+            break;
+        }
+    }
+    ApplyInputs(tick);
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include "IStepListener.h"
+#include "Command.h"
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+class Grid;
+class Simulation;
+class AgentManager;
+
+// Linha do tempo para voltar a simulação a qualquer passo recente: keyframes periódicos
+// (snapshots completos, ver SimulationSnapshot) mais, entre eles, os comandos que vieram de
+// fora da simulação a cada passo. O resto de um passo é função do estado (o passo é fixo e
+// os sorteios vêm de contadores), então rodar de novo a partir de um keyframe, reaplicando
+// esses comandos, refaz exatamente os mesmos passos. Ir para o passo T custa restaurar o
+// keyframe anterior a T e rodar no máximo keyframeInterval - 1 passos.
+//
+// A memória é limitada a maxKeyframes snapshots: ao capturar um novo além disso, o mais
+// antigo sai junto com os comandos anteriores ao keyframe seguinte, e a janela de
+// retrocesso fica em torno de keyframeInterval * maxKeyframes passos.
+//
+// Depois de voltar, avançar refaz os passos gravados até a frente da linha do tempo e
+// dali em diante continua ao vivo. Um comando novo (Issue) ou uma edição (MarkEdited) num
+// passo anterior à frente descarta o futuro gravado a partir dali.
+class Timeline : public IStepListener {
+public:
+    static constexpr int DEFAULT_KEYFRAME_INTERVAL = 120;
+    static constexpr int DEFAULT_MAX_KEYFRAMES = 16;
+
+private:
+    struct Keyframe {
+        uint64_t tick;
+        // Capturado por MarkEdited: o estado não sai de rodar o passo anterior.
+        bool edited;
+        std::vector<uint8_t> snapshot;
+    };
+
+    struct Input {
+        uint64_t tick;
+        Command command;
+    };
+
+    Grid* grid;
+    Simulation* simulation;
+    AgentManager* agentManager;
+    int keyframeInterval;
+    int maxKeyframes;
+
+    std::deque<Keyframe> keyframes;
+    // Comandos externos em ordem de passo (e de chegada dentro do passo).
+    std::deque<Input> inputs;
+    // Primeiro passo ainda não gravado: [keyframes.front().tick, head] é a janela navegável.
+    uint64_t head = 0;
+
+    void CaptureKeyframe(uint64_t tick, bool edited);
+    // Reenvia os comandos gravados para `tick`, ao chegar de novo a um passo já gravado.
+    void ApplyInputs(uint64_t tick);
+    // Descarta keyframes e comandos depois de `tick` (os do próprio tick ficam).
+    void TruncateAfter(uint64_t tick);
+
+public:
+    Timeline(Grid& grid, Simulation& simulation, AgentManager& agentManager,
+             int keyframeInterval = DEFAULT_KEYFRAME_INTERVAL, int maxKeyframes = DEFAULT_MAX_KEYFRAMES);
+    ~Timeline() override;
+
+    Timeline(const Timeline&) = delete;
+    Timeline& operator=(const Timeline&) = delete;
+
+    void SetAgentManager(AgentManager& manager) { agentManager = &manager; }
+
+    // Esquece tudo e começa uma linha do tempo nova com um keyframe no passo atual.
+    void Reset();
+
+    // Envia um comando de fora da simulação (entrada do usuário, script) e o grava para
+    // ser reaplicado ao refazer este passo.
+    void Issue(const Command& command);
+
+    // Avisa que o cenário foi mudado por fora dos comandos (obstáculos, agentes criados
+    // ou removidos, desfazer, opções): o futuro gravado é descartado e o estado atual vira
+    // um keyframe, para que voltar e refazer passe pela mudança.
+    void MarkEdited();
+
+    // Vai para o passo `tick`, limitado à janela navegável. Retorna o passo alcançado.
+    uint64_t Seek(uint64_t tick);
+    uint64_t StepBack(uint64_t ticks = 1);
+    // Um passo à frente: refaz um passo gravado ou, na frente, roda um passo novo.
+    uint64_t StepForward();
+
+    uint64_t GetOldestTick() const;
+    uint64_t GetHeadTick() const { return head; }
+    int GetKeyframeCount() const { return (int)keyframes.size(); }
+    int GetKeyframeInterval() const { return keyframeInterval; }
+    size_t GetMemoryBytes() const;
+
+    void OnStep(uint64_t tick) override;
+};
@@ -2,12 +2,21 @@
 #include "IAgentFactory.h"
 
 class BasicAgentFactory : public IAgentFactory {
+private:
+    uint64_t worldSeed;
+    
 public:
-    std::unique_ptr<Agent> CreateAgent(Vector2 start, Vector2 target) override {
-        return std::make_unique<Agent>(start, target);
+    explicit BasicAgentFactory(uint64_t worldSeed = 0) : worldSeed(worldSeed) {}
+    
+    void SetSeed(uint64_t seed) { worldSeed = seed; }
+    
+    Agent CreateAgent(AgentManager& agentManager, Vector2 start, Vector2 target) override {
+        return agentManager.AddAgent(start, target);
     }
     
     std::unique_ptr<AgentManager> CreateAgentManager(Grid* grid) override {
-        return std::make_unique<AgentManager>(grid);
+        auto manager = std::make_unique<AgentManager>(grid);
+        manager->SetWorldSeed(worldSeed);
+        return manager;
     }
 };
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+#include "ProceduralObstacleFactory.h"
+
+// Quarteirões: ruas em grade, prédios ocupando cada quarteirão (com calçada),
+// alguns quarteirões vazios (praças) e vielas sorteadas cortando os prédios.
+class CityBlockObstacleFactory : public ProceduralObstacleFactory {
+private:
+    int blockSize;
+    int streetWidth;
+    
+protected:
+    void FillRow(int y, int width, int /*height*/, uint8_t* blocked) const override {
+        int period = blockSize + streetWidth;
+        int by = y / period;
+        int ly = y % period - streetWidth;
+        
+        for (int x = 0; x < width; x++) {
+            int bx = x / period;
+            int lx = x % period - streetWidth;
+            
+            // Rua ou calçada.
+            if (lx < 1 || ly < 1 || lx >= blockSize - 1 || ly >= blockSize - 1) {
+                blocked[x] = 0;
+                continue;
+            }
+            
+            CounterRng rng(seed, ((uint64_t)by << 32) | (uint32_t)bx);
+            uint32_t kind = rng.At(0) % 10;
+            if (kind == 0) {
+                blocked[x] = 0;
+                continue;
+            }
+            
+            bool verticalAlley = kind >= 7 && lx == rng.RangeAt(0, 1, 2, blockSize - 3);
+            bool horizontalAlley = kind == 9 && ly == rng.RangeAt(0, 2, 2, blockSize - 3);
+            blocked[x] = !(verticalAlley || horizontalAlley);
+        }
+    }
+    
+public:
+    CityBlockObstacleFactory(uint64_t seed, int blockSize = 10, int streetWidth = 2, int threadCount = 0)
+        : ProceduralObstacleFactory(seed, threadCount), blockSize(blockSize < 5 ? 5 : blockSize),
+          streetWidth(streetWidth < 1 ? 1 : streetWidth) {}
+};
@@ -0,0 +1,10 @@
+#pragma once
+#include "IPathfinderFactory.h"
+#include "DialPathfinder.h"
+
+class DialPathfinderFactory : public IPathfinderFactory {
+public:
+    std::unique_ptr<Pathfinder> CreatePathfinder() override {
+        return std::make_unique<DialPathfinder>();
+    }
+};
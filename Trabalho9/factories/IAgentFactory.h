@@ -6,6 +6,6 @@
 class IAgentFactory {
 public:
     virtual ~IAgentFactory() = default;
-    virtual std::unique_ptr<Agent> CreateAgent(Vector2 start, Vector2 target) = 0;
+    virtual Agent CreateAgent(AgentManager& agentManager, Vector2 start, Vector2 target) = 0;
     virtual std::unique_ptr<AgentManager> CreateAgentManager(Grid* grid) = 0;
 };
\ No newline at end of file
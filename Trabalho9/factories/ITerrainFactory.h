@@ -0,0 +1,9 @@
+#pragma once
+#include "Grid.h"
+
+class ITerrainFactory {
+public:
+    virtual ~ITerrainFactory() = default;
+    virtual void CreateTerrain(Grid& grid, int patchCount) = 0;
+    virtual void SetTerrainAt(Grid& grid, int x, int y, uint8_t cost) = 0;
+};
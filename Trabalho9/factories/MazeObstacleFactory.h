@@ -0,0 +1,56 @@
+#pragma once
+#include "ProceduralObstacleFactory.h"
+#include <vector>
+
+// Labirinto perfeito pelo algoritmo Sidewinder. Células do labirinto ficam nas coordenadas
+// ímpares; cada linha do labirinto só depende de sorteios dela mesma, então qualquer linha
+// do grid pode ser gerada isoladamente.
+class MazeObstacleFactory : public ProceduralObstacleFactory {
+private:
+    // east[c]: passagem para a célula c + 1; north[c]: passagem para a linha de cima.
+    void MazeRow(int row, int columns, std::vector<uint8_t>& east, std::vector<uint8_t>& north) const {
+        CounterRng rng(seed, row);
+        east.assign(columns, 0);
+        north.assign(columns, 0);
+        
+        int runStart = 0;
+        for (int c = 0; c < columns; c++) {
+            bool lastColumn = c == columns - 1;
+            bool closeRun = row > 0 && (lastColumn || (rng.At(2 * c) & 1));
+            
+            if (closeRun) {
+                north[rng.RangeAt(1, c, runStart, c)] = 1;
+                runStart = c + 1;
+            } else if (!lastColumn) {
+                east[c] = 1;
+            }
+        }
+    }
+    
+protected:
+    void FillRow(int y, int width, int height, uint8_t* blocked) const override {
+        int columns = (width - 1) / 2;
+        int rows = (height - 1) / 2;
+        
+        for (int x = 0; x < width; x++) blocked[x] = 1;
+        if (columns <= 0 || rows <= 0) return;
+        
+        std::vector<uint8_t> east, north;
+        if (y % 2 == 1 && y / 2 < rows) {
+            MazeRow(y / 2, columns, east, north);
+            for (int c = 0; c < columns; c++) {
+                blocked[2 * c + 1] = 0;
+                if (east[c]) blocked[2 * c + 2] = 0;
+            }
+        } else if (y % 2 == 0 && y > 0 && y / 2 < rows) {
+            MazeRow(y / 2, columns, east, north);
+            for (int c = 0; c < columns; c++) {
+                if (north[c]) blocked[2 * c + 1] = 0;
+            }
+        }
+    }
+    
+public:
+    MazeObstacleFactory(uint64_t seed, int threadCount = 0)
+        : ProceduralObstacleFactory(seed, threadCount) {}
+};
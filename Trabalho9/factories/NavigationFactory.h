@@ -3,6 +3,7 @@
 #include "IPathfinderFactory.h"
 #include "IAgentFactory.h"
 #include "IObstacleFactory.h"
+#include "ITerrainFactory.h"
 #include <memory>
 
 class NavigationFactory {
@@ -11,16 +12,19 @@ private:
     std::unique_ptr<IPathfinderFactory> pathfinderFactory;
     std::unique_ptr<IAgentFactory> agentFactory;
     std::unique_ptr<IObstacleFactory> obstacleFactory;
+    std::unique_ptr<ITerrainFactory> terrainFactory;
     
 public:
     NavigationFactory(std::unique_ptr<IGridFactory> gridF,
                      std::unique_ptr<IPathfinderFactory> pathF,
                      std::unique_ptr<IAgentFactory> agentF,
-                     std::unique_ptr<IObstacleFactory> obstacleF)
+                     std::unique_ptr<IObstacleFactory> obstacleF,
+                     std::unique_ptr<ITerrainFactory> terrainF = nullptr)
         : gridFactory(std::move(gridF))
         , pathfinderFactory(std::move(pathF))
         , agentFactory(std::move(agentF))
-        , obstacleFactory(std::move(obstacleF)) {}
+        , obstacleFactory(std::move(obstacleF))
+        , terrainFactory(std::move(terrainF)) {}
     
     std::unique_ptr<Grid> CreateGrid(int w, int h, float cellSize) {
         return gridFactory->CreateGrid(w, h, cellSize);
@@ -30,8 +34,8 @@ public:
         return pathfinderFactory->CreatePathfinder();
     }
     
-    std::unique_ptr<Agent> CreateAgent(Vector2 start, Vector2 target) {
-        return agentFactory->CreateAgent(start, target);
+    Agent CreateAgent(AgentManager& agentManager, Vector2 start, Vector2 target) {
+        return agentFactory->CreateAgent(agentManager, start, target);
     }
     
     std::unique_ptr<AgentManager> CreateAgentManager(Grid* grid) {
@@ -45,4 +49,16 @@ public:
     void CreateObstacleAt(Grid& grid, int x, int y) {
         obstacleFactory->CreateObstacleAt(grid, x, y);
     }
+    
+    void CreateTerrain(Grid& grid, int patchCount) {
+        if (terrainFactory) {
+            terrainFactory->CreateTerrain(grid, patchCount);
+        }
+    }
+    
+    void SetTerrainAt(Grid& grid, int x, int y, uint8_t cost) {
+        if (terrainFactory) {
+            terrainFactory->SetTerrainAt(grid, x, y, cost);
+        }
+    }
 };
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+#include "ProceduralObstacleFactory.h"
+#include <cmath>
+
+// Ruído de valor fractal: manchas orgânicas de obstáculos (florestas, lagos, rochas).
+class NoiseObstacleFactory : public ProceduralObstacleFactory {
+private:
+    float featureSize;
+    float threshold;
+    int octaves;
+    
+    float Lattice(const CounterRng& rng, int x, int y) const {
+        return rng.UniformAt((uint32_t)x, (uint32_t)y);
+    }
+    
+    float ValueNoise(const CounterRng& rng, float x, float y) const {
+        int x0 = (int)std::floor(x);
+        int y0 = (int)std::floor(y);
+        float tx = x - x0;
+        float ty = y - y0;
+        tx = tx * tx * (3 - 2 * tx);
+        ty = ty * ty * (3 - 2 * ty);
+        
+        float a = Lattice(rng, x0, y0);
+        float b = Lattice(rng, x0 + 1, y0);
+        float c = Lattice(rng, x0, y0 + 1);
+        float d = Lattice(rng, x0 + 1, y0 + 1);
+        return (a + (b - a) * tx) + ((c + (d - c) * tx) - (a + (b - a) * tx)) * ty;
+    }
+    
+protected:
+    void FillRow(int y, int width, int /*height*/, uint8_t* blocked) const override {
+        for (int x = 0; x < width; x++) {
+            float value = 0;
+            float amplitude = 1;
+            float total = 0;
+            float frequency = 1.0f / featureSize;
+            for (int o = 0; o < octaves; o++) {
+                CounterRng rng(seed, o);
+                value += ValueNoise(rng, x * frequency, y * frequency) * amplitude;
+                total += amplitude;
+                amplitude *= 0.5f;
+                frequency *= 2;
+            }
+            blocked[x] = value / total > threshold;
+        }
+    }
+    
+public:
+    NoiseObstacleFactory(uint64_t seed, float featureSize = 12.0f, float threshold = 0.6f,
+                         int octaves = 3, int threadCount = 0)
+        : ProceduralObstacleFactory(seed, threadCount), featureSize(featureSize),
+          threshold(threshold), octaves(octaves) {}
+};
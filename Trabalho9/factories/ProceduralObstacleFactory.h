@@ -0,0 +1,44 @@
+#pragma once
+#include "IObstacleFactory.h"
+#include "CounterRng.h"
+#include "ParallelFor.h"
+#include <cstdint>
+#include <vector>
+
+// Base dos geradores procedurais. Cada linha do mapa é uma função pura de (seed, y),
+// então as linhas são preenchidas em paralelo e o resultado não depende do número de threads.
+// O parâmetro `count` de CreateObstacles é ignorado: a forma do mapa vem do gerador.
+class ProceduralObstacleFactory : public IObstacleFactory {
+protected:
+    uint64_t seed;
+    int threadCount;
+    
+    // Pré-cálculo sequencial opcional (ex.: salas), feito antes das linhas.
+    virtual void Prepare(int /*width*/, int /*height*/) {}
+    virtual void FillRow(int y, int width, int height, uint8_t* blocked) const = 0;
+    
+public:
+    ProceduralObstacleFactory(uint64_t seed, int threadCount = 0)
+        : seed(seed), threadCount(threadCount) {}
+    
+    void SetSeed(uint64_t newSeed) { seed = newSeed; }
+    
+    std::vector<uint8_t> GenerateMask(int width, int height) {
+        Prepare(width, height);
+        std::vector<uint8_t> blocked(width * height, 0);
+        ParallelFor(0, height, [&](int y0, int y1) {
+            for (int y = y0; y < y1; y++) {
+                FillRow(y, width, height, &blocked[y * width]);
+            }
+        }, threadCount);
+        return blocked;
+    }
+    
+    void CreateObstacles(Grid& grid, int /*count*/) override {
+        grid.ApplyObstacleMask(GenerateMask(grid.GetWidth(), grid.GetHeight()));
+    }
+    
+    void CreateObstacleAt(Grid& grid, int x, int y) override {
+        grid.SetOccupied(x, y, true);
+    }
+};
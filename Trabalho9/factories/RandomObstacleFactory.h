@@ -1,20 +1,30 @@
 #pragma once
 #include "IObstacleFactory.h"
-#include "raylib.h"
+#include "Random.h"
 
 class RandomObstacleFactory : public IObstacleFactory {
+private:
+    SeedableRandom random;
+    
 public:
+    RandomObstacleFactory() = default;
+    explicit RandomObstacleFactory(uint64_t seed) : random(seed) {}
+    
+    void SetSeed(uint64_t seed) { random.SetSeed(seed); }
+    
     void CreateObstacles(Grid& grid, int count) override {
         int width = grid.GetWidth();
         int height = grid.GetHeight();
         
+        grid.BeginBatchEdit();
         for (int i = 0; i < count; i++) {
-            int x = GetRandomValue(0, width-1);
-            int y = GetRandomValue(0, height-1);
-            if (GetRandomValue(0, 100) < 25) {
+            int x = random.Range(0, width-1);
+            int y = random.Range(0, height-1);
+            if (random.Range(0, 100) < 25) {
                 grid.SetOccupied(x, y, true);
             }
         }
+        grid.EndBatchEdit();
     }
     
     void CreateObstacleAt(Grid& grid, int x, int y) override {
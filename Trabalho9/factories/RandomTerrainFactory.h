@@ -0,0 +1,38 @@
+#pragma once
+#include "ITerrainFactory.h"
+#include "Random.h"
+
+// Cria manchas quadradas de terreno lento (lama, areia...) com custos aleatórios.
+class RandomTerrainFactory : public ITerrainFactory {
+private:
+    int maxCost;
+    int maxPatchRadius;
+    SeedableRandom random;
+    
+public:
+    RandomTerrainFactory(int maxCost = 9, int maxPatchRadius = 3)
+        : maxCost(maxCost), maxPatchRadius(maxPatchRadius) {}
+    RandomTerrainFactory(uint64_t seed, int maxCost, int maxPatchRadius)
+        : maxCost(maxCost), maxPatchRadius(maxPatchRadius), random(seed) {}
+    
+    void SetSeed(uint64_t seed) { random.SetSeed(seed); }
+    
+    void CreateTerrain(Grid& grid, int patchCount) override {
+        for (int i = 0; i < patchCount; i++) {
+            int cx = random.Range(0, grid.GetWidth() - 1);
+            int cy = random.Range(0, grid.GetHeight() - 1);
+            int radius = random.Range(0, maxPatchRadius);
+            uint8_t cost = (uint8_t)random.Range(2, maxCost);
+            
+            for (int y = cy - radius; y <= cy + radius; y++) {
+                for (int x = cx - radius; x <= cx + radius; x++) {
+                    grid.SetTerrainCost(x, y, cost);
+                }
+            }
+        }
+    }
+    
+    void SetTerrainAt(Grid& grid, int x, int y, uint8_t cost) override {
+        grid.SetTerrainCost(x, y, cost);
+    }
+};
@@ -0,0 +1,74 @@
+#pragma once
+#include "ProceduralObstacleFactory.h"
+#include <algorithm>
+#include <vector>
+
+// Salas e corredores: o mapa é dividido em setores e cada setor recebe uma sala.
+// Corredores em L ligam cada sala às vizinhas da direita e de baixo, então tudo fica conectado.
+class RoomsObstacleFactory : public ProceduralObstacleFactory {
+private:
+    struct Room {
+        int x0, y0, x1, y1;
+        int cx, cy;
+    };
+    
+    int sectorSize;
+    int sectorsX = 0, sectorsY = 0;
+    std::vector<Room> rooms;
+    
+    const Room& RoomAt(int sx, int sy) const { return rooms[sy * sectorsX + sx]; }
+    
+    static void Carve(uint8_t* blocked, int width, int x0, int x1) {
+        if (x0 > x1) std::swap(x0, x1);
+        x0 = std::max(x0, 0);
+        x1 = std::min(x1, width - 1);
+        for (int x = x0; x <= x1; x++) blocked[x] = 0;
+    }
+    
+    // Corredor de a até b: horizontal na linha de a, depois vertical na coluna de b.
+    static void CarveCorridorRow(uint8_t* blocked, int width, int y, const Room& a, const Room& b) {
+        if (y == a.cy) Carve(blocked, width, a.cx, b.cx);
+        if (y >= std::min(a.cy, b.cy) && y <= std::max(a.cy, b.cy)) Carve(blocked, width, b.cx, b.cx);
+    }
+    
+protected:
+    void Prepare(int width, int height) override {
+        sectorsX = std::max(1, width / sectorSize);
+        sectorsY = std::max(1, height / sectorSize);
+        rooms.resize(sectorsX * sectorsY);
+        
+        int sectorW = width / sectorsX;
+        int sectorH = height / sectorsY;
+        
+        for (int sy = 0; sy < sectorsY; sy++) {
+            for (int sx = 0; sx < sectorsX; sx++) {
+                CounterRng rng(seed, (uint64_t)sy * sectorsX + sx);
+                int w = rng.RangeAt(0, 0, std::max(1, sectorW / 3), std::max(1, sectorW - 3));
+                int h = rng.RangeAt(0, 1, std::max(1, sectorH / 3), std::max(1, sectorH - 3));
+                int x0 = sx * sectorW + rng.RangeAt(0, 2, 1, std::max(1, sectorW - w - 1));
+                int y0 = sy * sectorH + rng.RangeAt(0, 3, 1, std::max(1, sectorH - h - 1));
+                rooms[sy * sectorsX + sx] = {x0, y0, x0 + w - 1, y0 + h - 1, x0 + w / 2, y0 + h / 2};
+            }
+        }
+    }
+    
+    void FillRow(int y, int width, int height, uint8_t* blocked) const override {
+        for (int x = 0; x < width; x++) blocked[x] = 1;
+        
+        int sectorH = height / sectorsY;
+        int sy = std::min(y / std::max(1, sectorH), sectorsY - 1);
+        
+        for (int row = std::max(0, sy - 1); row <= std::min(sectorsY - 1, sy + 1); row++) {
+            for (int sx = 0; sx < sectorsX; sx++) {
+                const Room& room = RoomAt(sx, row);
+                if (y >= room.y0 && y <= room.y1) Carve(blocked, width, room.x0, room.x1);
+                if (sx + 1 < sectorsX) CarveCorridorRow(blocked, width, y, room, RoomAt(sx + 1, row));
+                if (row + 1 < sectorsY) CarveCorridorRow(blocked, width, y, room, RoomAt(sx, row + 1));
+            }
+        }
+    }
+    
+public:
+    RoomsObstacleFactory(uint64_t seed, int sectorSize = 16, int threadCount = 0)
+        : ProceduralObstacleFactory(seed, threadCount), sectorSize(std::max(6, sectorSize)) {}
+};
@@ -0,0 +1,15 @@
+#include "AgentRenderer.h"
+
+Vector2 AgentRenderer::InterpolatedPosition(const AgentStorage& agents, int index, float alpha) {
+    return {agents.previousX[index] + (agents.positionX[index] - agents.previousX[index]) * alpha,
+            agents.previousY[index] + (agents.positionY[index] - agents.previousY[index]) * alpha};
+}
+
+void AgentRenderer::DrawAll(AgentManager& agentManager, Grid& grid, float alpha) {
+    const AgentStorage& agents = agentManager.GetStorage();
+    int count = agents.Size();
+    for (int i = 0; i < count; i++) {
+        Vector2 position = InterpolatedPosition(agents, i, alpha);
+        DrawCircle(position.x, position.y, grid.GetCellSize() / 3, agents.cold[i].color);
+    }
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include "raylib.h"
+#include "AgentManager.h"
+#include "Grid.h"
+
+// Desenho dos agentes. alpha interpola entre a posição do início e do fim do último
+// passo da simulação (1 = posição atual), ver Simulation::Advance.
+class AgentRenderer {
+public:
+    static Vector2 InterpolatedPosition(const AgentStorage& agents, int index, float alpha);
+    static void DrawAll(AgentManager& agentManager, Grid& grid, float alpha = 1.0f);
+};
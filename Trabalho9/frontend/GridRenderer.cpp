@@ -0,0 +1,71 @@
+#include "GridRenderer.h"
+
+GridRenderer::~GridRenderer() {
+    if (renderCache.id != 0) {
+        UnloadRenderTexture(renderCache);
+    }
+}
+
+Color GridRenderer::TerrainColor(int cost) {
+    float t = (cost - 1) / 254.0f;
+    t = t > 0 ? 0.35f + 0.65f * t : 0.0f;
+    Color from = GREEN;
+    Color to = BROWN;
+    return {(unsigned char)(from.r + (to.r - from.r) * t),
+            (unsigned char)(from.g + (to.g - from.g) * t),
+            (unsigned char)(from.b + (to.b - from.b) * t), 255};
+}
+
+void GridRenderer::DrawCell(int x, int y) {
+    float cellSize = grid.GetCellSize();
+    Node* node = grid.GetNode(x, y);
+    Color color = node->occupied ? RED : TerrainColor(grid.GetTerrainCost(x, y));
+    if (!node->walkable) color = DARKGRAY;
+    
+    DrawRectangle(x * cellSize, y * cellSize, cellSize - 1, cellSize - 1, color);
+    DrawRectangleLines(x * cellSize, y * cellSize, cellSize, cellSize, LIGHTGRAY);
+}
+
+void GridRenderer::Draw() {
+    int width = grid.GetWidth();
+    int height = grid.GetHeight();
+    int textureWidth = (int)(width * grid.GetCellSize());
+    int textureHeight = (int)(height * grid.GetCellSize());
+    bool fullRedraw = false;
+    
+    // Um snapshot restaurado pode trocar as dimensões do grid.
+    if (renderCache.id != 0 &&
+        (renderCache.texture.width != textureWidth || renderCache.texture.height != textureHeight)) {
+        UnloadRenderTexture(renderCache);
+        renderCache = {0};
+    }
+    if (renderCache.id == 0) {
+        renderCache = LoadRenderTexture(textureWidth, textureHeight);
+        fullRedraw = true;
+    }
+    
+    renderDirty.clear();
+    if (!grid.CollectDirtyCells(renderCursor, renderDirty)) {
+        fullRedraw = true;
+    }
+    
+    if (fullRedraw || !renderDirty.empty()) {
+        BeginTextureMode(renderCache);
+        if (fullRedraw) {
+            ClearBackground(BLANK);
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    DrawCell(x, y);
+                }
+            }
+        } else {
+            for (int cell : renderDirty) {
+                DrawCell(cell % width, cell / width);
+            }
+        }
+        EndTextureMode();
+    }
+    
+    // Render textures ficam de cabeça para baixo no OpenGL, daí a altura negativa.
+    DrawTextureRec(renderCache.texture, {0, 0, (float)textureWidth, -(float)textureHeight}, {0, 0}, WHITE);
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include "raylib.h"
+#include "Grid.h"
+#include <cstdint>
+#include <vector>
+
+// Desenho do grid retangular. O grid é desenhado uma vez numa render texture; nos quadros
+// seguintes só as células alteradas (Grid::CollectDirtyCells) são redesenhadas nela, e a
+// tela recebe um único DrawTextureRec.
+class GridRenderer {
+private:
+    Grid& grid;
+    
+    RenderTexture2D renderCache = {0};
+    uint64_t renderCursor = 0;
+    std::vector<int> renderDirty;
+    
+    void DrawCell(int x, int y);
+    
+public:
+    GridRenderer(Grid& grid) : grid(grid) {}
+    ~GridRenderer();
+    
+    GridRenderer(const GridRenderer&) = delete;
+    GridRenderer& operator=(const GridRenderer&) = delete;
+    
+    void Draw();
+    static Color TerrainColor(int cost);
+};
@@ -0,0 +1,499 @@
+#include "raylib.h"
+#include "Grid.h"
+#include "AgentManager.h"
+#include "Metrics.h"
+#include "NavigationFactory.h"
+#include "BasicGridFactory.h"
+#include "AStarPathfinderFactory.h"
+#include "BasicAgentFactory.h"
+#include "RandomObstacleFactory.h"
+#include "RandomTerrainFactory.h"
+#include "NoiseObstacleFactory.h"
+#include "MazeObstacleFactory.h"
+#include "RoomsObstacleFactory.h"
+#include "CityBlockObstacleFactory.h"
+#include "RectangularGridAdapter.h"
+#include "HexagonalGridAdapter.h"
+#include "StaticBehaviors.h"
+#include "BasicAgentBehavior.h"
+#include "SmartPathfindingDecorator.h"
+#include "SpeedBoostDecorator.h"
+#include "GridInitializationHandler.h"
+#include "AgentManagerInitializationHandler.h"
+#include "CollisionMetricsSubscriber.h"
+#include "CollisionHighlightSubscriber.h"
+#include "CollisionLogSubscriber.h"
+#include "Simulation.h"
+#include "HeadlessRunner.h"
+#include "SimulationSnapshot.h"
+#include "Timeline.h"
+#include "CheckpointWriter.h"
+#include "Random.h"
+#include "AgentRenderer.h"
+#include <memory>
+
+// Seed de todos os sorteios dos testes de performance: cada execução monta os mesmos
+// grids e agentes, então os tempos medidos são comparáveis entre execuções.
+constexpr uint64_t PERFORMANCE_SEED = 42;
+
+// Cadeia de decoradores com as mesmas camadas de MakeStaticBehavior(smart, fast), montada
+// em tempo de execução. Usada pela tecla V para trocar o comportamento de um agente vivo.
+std::unique_ptr<IAgentBehavior> MakeDecoratedBehavior(bool smart, bool fast) {
+    std::unique_ptr<IAgentBehavior> behavior = std::make_unique<BasicAgentBehavior>();
+    if (smart) {
+        behavior = std::make_unique<SmartPathfindingDecorator>(std::move(behavior));
+    }
+    if (fast) {
+        behavior = std::make_unique<SpeedBoostDecorator>(std::move(behavior));
+    }
+    return behavior;
+}
+
+void RunPerformanceTests(std::unique_ptr<NavigationFactory>& factory) {
+    //printf("Iniciando testes de performance...\n");
+    Random::Seed(PERFORMANCE_SEED);
+    
+    std::vector<std::pair<int, int>> gridSizes = {{10, 10}, {20, 20}, {40, 40}};
+    std::vector<int> agentCounts = {1, 5, 10, 20};
+    
+    for (auto& gridSize : gridSizes) {
+        int width = gridSize.first;
+        int height = gridSize.second;
+        float cellSize = 20.0f;
+        
+        auto grid = factory->CreateGrid(width, height, cellSize);
+        auto agentManager = factory->CreateAgentManager(grid.get());
+        
+        factory->CreateObstacles(*grid, (width * height) / 8);
+        factory->CreateTerrain(*grid, (width * height) / 40);
+        
+        for (int agents : agentCounts) {
+            //printf("Testando: Grid %dx%d com %d agentes\n", width, height, agents);
+            
+            if (grid->GetFreeCellCount() < 2) break;
+            for (int i = 0; i < agents; i++) {
+                int startX, startY, targetX, targetY;
+                grid->RandomFreeCell(startX, startY);
+                do {
+                    grid->RandomFreeCell(targetX, targetY);
+                } while (startX == targetX && startY == targetY);
+                
+                Vector2 start = {(float)startX, (float)startY};
+                Vector2 target = {(float)targetX, (float)targetY};
+                agentManager->AddAgent(start, target);
+            }
+            
+            Simulation simulation(*agentManager);
+            simulation.RunTicks(60);
+        }
+    }
+    
+    Metrics::SaveToCSV("performance_data.csv");
+    //printf("Testes concluídos! Dados salvos em performance_data.csv!\n");
+}
+
+#include "raylib.h"
+#include "Grid.h"
+#include "AgentManager.h"
+#include "Metrics.h"
+#include "NavigationFactory.h"
+#include "BasicGridFactory.h"
+#include "AStarPathfinderFactory.h"
+#include "BasicAgentFactory.h"
+#include "RandomObstacleFactory.h"
+#include "RectangularGridAdapter.h"
+#include "HexagonalGridAdapter.h"
+
+
+int main(int argc, char** argv) {
+    HeadlessOptions headlessOptions;
+    if (ParseHeadlessOptions(argc, argv, headlessOptions)) {
+        return RunHeadless(headlessOptions);
+    }
+    if (!headlessOptions.valid) {
+        return 1;
+    }
+
+    const int screenWidth = 800;
+    const int screenHeight = 600;
+    const float cellSize = 60.0f;
+    const int numCols = screenWidth / cellSize;
+    const int numRows = screenHeight / cellSize;
+
+    auto gridInitializer = std::make_unique<GridInitializationHandler>(numCols, numRows, cellSize);
+    auto agentManagerInitializer = std::make_unique<AgentManagerInitializationHandler>();
+
+    gridInitializer->SetNext(std::move(agentManagerInitializer));
+    gridInitializer->Handle();
+
+    auto& grid = Grid::GetInstance();
+    // Ponteiro, não referência: C destrói o gerenciador e cria outro.
+    AgentManager* agentManager = &AgentManager::GetInstance();
+
+    Vector2 spawnPos = {-1, -1};
+    Vector2 targetPos = {-1, -1};
+    bool placingSpawn = false;
+    bool placingTarget = false;
+
+    CollisionMetricsSubscriber collisionMetrics;
+    CollisionHighlightSubscriber collisionHighlight;
+    CollisionLogSubscriber collisionLog;
+    bool collisionDamage = false;
+    bool collisionLogging = false;
+    agentManager->GetCollisionEvents().Subscribe(&collisionMetrics);
+    agentManager->GetCollisionEvents().Subscribe(&collisionHighlight);
+
+    std::unique_ptr<IGridAdapter> gridAdapter = std::make_unique<RectangularGridAdapter>(grid);
+    bool useHexagonalGrid = false;
+    bool useSmartAgents = false;
+    bool useFastAgents = false;
+    bool paintingTerrain = false;
+    int terrainBrushCost = 5;
+
+    std::vector<std::unique_ptr<ProceduralObstacleFactory>> mapGenerators;
+    mapGenerators.push_back(std::make_unique<NoiseObstacleFactory>(0, 4.0f));
+    mapGenerators.push_back(std::make_unique<MazeObstacleFactory>(0));
+    mapGenerators.push_back(std::make_unique<RoomsObstacleFactory>(0, 6));
+    mapGenerators.push_back(std::make_unique<CityBlockObstacleFactory>(0, 5, 1));
+    const char* mapGeneratorNames[] = {"NOISE", "MAZE", "ROOMS", "CITY"};
+    int mapGeneratorIndex = -1;
+    uint64_t mapSeed = 1;
+
+    Simulation simulation(*agentManager);
+    
+    // F5 guarda o estado em memória (e em disco, em segundo plano); F9 volta para ele.
+    std::vector<uint8_t> quickSave;
+    std::vector<uint8_t> quickSaveFile;
+    CheckpointWriter checkpointWriter;
+    
+    // Linha do tempo para voltar e avançar passos. Toda mudança feita por fora dos comandos
+    // marca `edited`, e o quadro avisa a Timeline uma vez antes de avançar a simulação. O
+    // agente do D é sorteado fora do Random global, que faz parte do estado gravado.
+    Timeline timeline(grid, simulation, *agentManager);
+    SeedableRandom inputRandom(1);
+    bool paused = false;
+    bool edited = false;
+
+    InitWindow(screenWidth, screenHeight, "Grid Navigation with Advanced Patterns");
+
+    SetTargetFPS(60);
+
+    while (!WindowShouldClose()) {
+        Vector2 mousePos = GetMousePosition();
+        int gridX = mousePos.x / cellSize;
+        int gridY = mousePos.y / cellSize;
+
+        if (IsKeyPressed(KEY_H)) {
+            useHexagonalGrid = !useHexagonalGrid;
+            if (useHexagonalGrid) {
+                gridAdapter = std::make_unique<HexagonalGridAdapter>(grid);
+                //printf("Modo hexagonal ativado!\n");
+            } else {
+                gridAdapter = std::make_unique<RectangularGridAdapter>(grid);
+                //printf("Modo retangular ativado!\n");
+            }
+        }
+
+        if (IsKeyPressed(KEY_F)) {
+            useFastAgents = !useFastAgents;
+            //printf("Agentes rápidos: %s\n", useFastAgents ? "ATIVADO" : "DESATIVADO");
+        }
+
+        if (IsKeyPressed(KEY_I)) {
+            useSmartAgents = !useSmartAgents;
+            //printf("Agentes inteligentes: %s\n", useSmartAgents ? "ATIVADO" : "DESATIVADO");
+        }
+
+        if (IsKeyPressed(KEY_N)) {
+            mapGeneratorIndex = (mapGeneratorIndex + 1) % (int)mapGenerators.size();
+            mapGenerators[mapGeneratorIndex]->SetSeed(mapSeed++);
+            mapGenerators[mapGeneratorIndex]->CreateObstacles(grid, 0);
+            edited = true;
+        }
+
+        if (IsKeyPressed(KEY_G)) {
+            paintingTerrain = !paintingTerrain;
+        }
+
+        for (int key = KEY_ONE; key <= KEY_NINE; key++) {
+            if (IsKeyPressed(key)) {
+                terrainBrushCost = key - KEY_ZERO;
+            }
+        }
+
+        if (IsMouseButtonDown(MOUSE_LEFT_BUTTON)) {
+            edited = true;
+            if (paintingTerrain) {
+                gridAdapter->SetTerrainCost(gridX, gridY, (uint8_t)terrainBrushCost);
+            } else {
+                gridAdapter->SetOccupied(gridX, gridY, true);
+            }
+        }
+        
+        if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON)) {
+            if (placingSpawn && gridAdapter->IsWalkable(gridX, gridY)) {
+                spawnPos = {(float)gridX, (float)gridY};
+                placingSpawn = false;
+                placingTarget = false;
+            }
+            else if (placingTarget && gridAdapter->IsWalkable(gridX, gridY)) {
+                targetPos = {(float)gridX, (float)gridY};
+                placingTarget = false;
+                placingSpawn = false;
+            }
+            else if (paintingTerrain) {
+                gridAdapter->SetTerrainCost(gridX, gridY, 1);
+                edited = true;
+            }
+            else {
+                gridAdapter->SetOccupied(gridX, gridY, false);
+                edited = true;
+            }
+        }
+
+        if (IsKeyPressed(KEY_S)) {
+            placingSpawn = true;
+            placingTarget = false;
+        }
+        if (IsKeyPressed(KEY_T)) {
+            placingTarget = true;
+            placingSpawn = false;
+        }
+        
+        if (IsKeyPressed(KEY_ESCAPE)) {
+            placingSpawn = false;
+            placingTarget = false;
+        }
+
+        if (IsKeyPressed(KEY_ENTER)) {
+            if (spawnPos.x >= 0 && spawnPos.y >= 0 && targetPos.x >= 0 && targetPos.y >= 0 &&
+                gridAdapter->IsWalkable((int)spawnPos.x, (int)spawnPos.y) && 
+                gridAdapter->IsWalkable((int)targetPos.x, (int)targetPos.y)) {
+                
+                agentManager->AddAgentWithBehavior(spawnPos, targetPos,
+                                                   MakeStaticBehavior(useSmartAgents, useFastAgents));
+                edited = true;
+                spawnPos = {-1, -1};
+                targetPos = {-1, -1};
+            }
+        }
+
+        if (IsKeyPressed(KEY_R)) {
+            for (int i = 0; i < 5; i++) {
+                int startX, startY, targetX, targetY;
+                if (!grid.RandomFreeCell(startX, startY)) break;
+                grid.RandomFreeCellInComponent(grid.GetComponent(startX, startY), targetX, targetY);
+                Vector2 start = {(float)startX, (float)startY};
+                Vector2 target = {(float)targetX, (float)targetY};
+                
+                agentManager->AddAgentWithBehavior(start, target, MakeStaticBehavior(useSmartAgents, useFastAgents));
+                edited = true;
+            }
+        }
+
+        // V: o agente mais próximo do cursor passa a usar os decoradores com o F/I atuais.
+        if (IsKeyPressed(KEY_V)) {
+            int nearest = -1;
+            float nearestDistanceSq = cellSize * cellSize;
+            for (int i = 0; i < agentManager->GetAgentCount(); i++) {
+                Vector2 position = agentManager->GetAgent(i).GetPosition();
+                float dx = position.x - mousePos.x;
+                float dy = position.y - mousePos.y;
+                if (dx * dx + dy * dy < nearestDistanceSq) {
+                    nearestDistanceSq = dx * dx + dy * dy;
+                    nearest = i;
+                }
+            }
+            if (nearest >= 0) {
+                agentManager->GetAgent(nearest).SetBehavior(MakeDecoratedBehavior(useSmartAgents, useFastAgents));
+                edited = true;
+            }
+        }
+
+        if (IsKeyPressed(KEY_X)) {
+            for (int i = 0; i < 5 && agentManager->GetAgentCount() > 0; i++) {
+                int agentIndex = Random::Range(0, agentManager->GetAgentCount() - 1);
+                agentManager->RemoveAgent(agentManager->GetAgent(agentIndex).GetHandle());
+                edited = true;
+            }
+        }
+
+        if (IsKeyPressed(KEY_P)) {
+            Metrics::Clear();
+            auto navigationFactory = std::make_unique<NavigationFactory>(
+                std::make_unique<BasicGridFactory>(),
+                std::make_unique<AStarPathfinderFactory>(),
+                std::make_unique<BasicAgentFactory>(PERFORMANCE_SEED),
+                std::make_unique<RandomObstacleFactory>(PERFORMANCE_SEED),
+                std::make_unique<RandomTerrainFactory>(PERFORMANCE_SEED, 9, 3)
+            );
+            RunPerformanceTests(navigationFactory);
+            edited = true;
+        }
+
+        if (IsKeyPressed(KEY_M)) {
+            Metrics::SaveToCSV("manual_performance_data.csv");
+            //printf("Métricas salvas manualmente em manual_performance_data.csv!\n");
+        }
+
+        if (IsKeyPressed(KEY_C)) {
+            AgentManager::DestroyInstance();
+            agentManager = &AgentManager::CreateInstance(&grid);
+            simulation.SetAgentManager(*agentManager);
+            agentManager->GetCollisionEvents().Subscribe(&collisionMetrics);
+            agentManager->GetCollisionEvents().Subscribe(&collisionHighlight);
+            if (collisionLogging) agentManager->GetCollisionEvents().Subscribe(&collisionLog);
+            agentManager->SetCollisionDamageEnabled(collisionDamage);
+            timeline.SetAgentManager(*agentManager);
+            timeline.Reset();
+            //printf("Todos os agentes removidos!\n");
+        }
+
+        if (IsKeyPressed(KEY_D)) {
+            if (agentManager->GetAgentCount() > 0) {
+                int agentIndex = inputRandom.Range(0, agentManager->GetAgentCount() - 1);
+                timeline.Issue(Command::Damage(agentManager->GetAgent(agentIndex).GetHandle(), 101,
+                                               simulation.GetSimulationTime()));
+            }
+        }
+
+        if (IsKeyPressed(KEY_K)) {
+            collisionDamage = !collisionDamage;
+            agentManager->SetCollisionDamageEnabled(collisionDamage);
+            edited = true;
+        }
+
+        if (IsKeyPressed(KEY_O)) {
+            agentManager->SetSteeringEnabled(!agentManager->IsSteeringEnabled());
+            edited = true;
+        }
+
+        if (IsKeyPressed(KEY_L)) {
+            collisionLogging = !collisionLogging;
+            if (collisionLogging) {
+                agentManager->GetCollisionEvents().Subscribe(&collisionLog);
+            } else {
+                agentManager->GetCollisionEvents().Unsubscribe(&collisionLog);
+            }
+        }
+
+        if (IsKeyPressed(KEY_U)) {
+            agentManager->UndoLastCommand();
+            edited = true;
+        }
+
+        if (IsKeyPressed(KEY_F5)) {
+            CaptureSnapshot(grid, simulation, *agentManager, quickSave);
+            quickSaveFile = quickSave;
+            checkpointWriter.Submit(quickSaveFile, "quicksave.snap");
+        }
+
+        // Um snapshot inválido não muda nada; a gravação continua como estava.
+        if (IsKeyPressed(KEY_F9) && !quickSave.empty() &&
+            RestoreSnapshot(quickSave, grid, simulation, *agentManager)) {
+            collisionDamage = agentManager->IsCollisionDamageEnabled();
+            timeline.Reset();
+            edited = false;
+        }
+
+        if (edited) {
+            timeline.MarkEdited();
+            edited = false;
+        }
+
+        if (IsKeyPressed(KEY_SPACE)) {
+            paused = !paused;
+        }
+
+        // Setas: um passo para trás/frente (pausa); B volta 10 segundos; HOME/END vão para
+        // o começo e o fim da janela gravada.
+        if (IsKeyPressed(KEY_LEFT)) {
+            paused = true;
+            timeline.StepBack();
+        }
+        if (IsKeyPressed(KEY_RIGHT)) {
+            paused = true;
+            timeline.StepForward();
+        }
+        if (IsKeyPressed(KEY_B)) {
+            timeline.StepBack((uint64_t)(10.0 / simulation.GetFixedDelta()));
+        }
+        if (IsKeyPressed(KEY_HOME)) {
+            timeline.Seek(timeline.GetOldestTick());
+        }
+        if (IsKeyPressed(KEY_END)) {
+            timeline.Seek(timeline.GetHeadTick());
+        }
+        collisionDamage = agentManager->IsCollisionDamageEnabled();
+
+        float alpha = paused ? 1.0f : simulation.Advance(GetFrameTime());
+
+        BeginDrawing();
+            ClearBackground(RAYWHITE);
+            
+            gridAdapter->Draw();
+            AgentRenderer::DrawAll(*agentManager, grid, alpha);
+            for (int i = 0; i < agentManager->GetAgentCount(); i++) {
+                Agent agent = agentManager->GetAgent(i);
+                if (!collisionHighlight.IsInContact(agent.GetHandle())) continue;
+                Vector2 position = agent.GetPosition();
+                DrawCircleLines((int)position.x, (int)position.y, agent.getCollisionRadius() + 2, RED);
+            }
+                       
+            
+            if (spawnPos.x >= 0 && spawnPos.y >= 0) {
+                DrawRectangle(spawnPos.x * cellSize, spawnPos.y * cellSize, cellSize, cellSize, BLUE);
+                DrawText("SPAWN", spawnPos.x * cellSize, spawnPos.y * cellSize - 15, 10, BLUE);
+            }
+            if (targetPos.x >= 0 && targetPos.y >= 0) {
+                DrawRectangle(targetPos.x * cellSize, targetPos.y * cellSize, cellSize, cellSize, ORANGE);
+                DrawText("TARGET", targetPos.x * cellSize, targetPos.y * cellSize - 15, 10, ORANGE);
+            }
+
+            DrawText("Left click: Place obstacle", 10, 10, 20, DARKGRAY);
+            DrawText("Right click: Remove obstacle / Place spawn/target", 10, 35, 20, DARKGRAY);
+            DrawText("S: Set spawn mode | T: Set target mode", 10, 60, 20, DARKGRAY);
+            DrawText("ENTER: Create agent | R: 5 random agents | X: Remove 5", 10, 85, 20, DARKGRAY);
+            DrawText("H: Toggle Hexagonal/Retangular grid", 10, 110, 20, DARKGRAY);
+            DrawText("F: Toggle Fast agents | I: Toggle Smart agents | V: Apply to agent", 10, 135, 20, DARKGRAY);
+            DrawText("P: Run performance tests | M: Save metrics | F5/F9: Save/Load", 10, 160, 20, DARKGRAY);
+            DrawText("C: Clear all agents | ESC: Cancel placement", 10, 185, 20, DARKGRAY);
+            DrawText(TextFormat("Agents: %d (active: %d) | Collisions: %d (broad: %d)", agentManager->GetAgentCount(),
+                    agentManager->GetActiveAgentCount(), collisionMetrics.GetContactCount(), collisionMetrics.GetBroadCount()), 10, 210, 20, DARKGRAY);
+            
+            DrawText(TextFormat("Grid: %s", useHexagonalGrid ? "HEXAGONAL" : "RETANGULAR"), 
+                    10, 235, 20, useHexagonalGrid ? BLUE : DARKGRAY);
+            DrawText(TextFormat("Fast Agents: %s", useFastAgents ? "ON" : "OFF"), 
+                    10, 260, 20, useFastAgents ? GREEN : DARKGRAY);
+            DrawText(TextFormat("Smart Agents: %s", useSmartAgents ? "ON" : "OFF"), 
+                    10, 285, 20, useSmartAgents ? PURPLE : DARKGRAY);
+            DrawText(TextFormat("G: Terrain brush %s | 1-9: cost (%d)", paintingTerrain ? "ON" : "OFF", terrainBrushCost), 
+                    10, 310, 20, paintingTerrain ? BROWN : DARKGRAY);
+            DrawText(TextFormat("N: Generate map (%s)", mapGeneratorIndex >= 0 ? mapGeneratorNames[mapGeneratorIndex] : "NONE"), 
+                    10, 335, 20, DARKGRAY);
+            DrawText(TextFormat("K: Collision damage %s | L: Collision log %s", collisionDamage ? "ON" : "OFF",
+                    collisionLogging ? "ON" : "OFF"), 10, 360, 20, collisionDamage ? RED : DARKGRAY);
+            DrawText(TextFormat("O: Local avoidance (ORCA) %s", agentManager->IsSteeringEnabled() ? "ON" : "OFF"),
+                    10, 385, 20, agentManager->IsSteeringEnabled() ? DARKGREEN : DARKGRAY);
+            
+            DrawText(TextFormat("Tick %llu [%llu..%llu]%s | SPACE: Pause | LEFT/RIGHT: Step | B: -10 s",
+                    (unsigned long long)simulation.GetTick(), (unsigned long long)timeline.GetOldestTick(),
+                    (unsigned long long)timeline.GetHeadTick(), paused ? " PAUSED" : ""), 10, 410, 20,
+                    paused ? MAROON : DARKGRAY);
+            
+            if (placingSpawn) {
+                DrawText("MODE: Placing SPAWN (Right click to place)", 10, 435, 20, BLUE);
+            } else if (placingTarget) {
+                DrawText("MODE: Placing TARGET (Right click to place)", 10, 435, 20, ORANGE);
+            }
+            
+        EndDrawing();
+    }
+
+    AgentManager::DestroyInstance();
+    Grid::DestroyInstance();
+
+    CloseWindow();
+
+    return 0;
+}
@@ -1,50 +1,111 @@
 #include "HexagonalGridAdapter.h"
 #include "raylib.h"
+#include "GridRenderer.h"
 #include <cmath>
 #include <cstring>
+#include <algorithm>
 
+HexagonalGridAdapter::~HexagonalGridAdapter() {
+    if (renderCache.id != 0) {
+        UnloadRenderTexture(renderCache);
+    }
+}
+
+Vector2 HexagonalGridAdapter::CellCenter(int x, int y) const {
+    float cellSize = grid.GetCellSize();
+    float hexWidth = cellSize;
+    float hexHeight = cellSize * 0.866f;
+    
+    float posX, posY;
+    
+    if (y % 2 == 0) {
+        posX = x * hexWidth;
+        posY = y * hexHeight * 0.75f;
+    } else {
+        posX = x * hexWidth + hexWidth / 2;
+        posY = y * hexHeight * 0.75f;
+    }
+    
+    return {posX + cellSize / 2, posY + cellSize / 2};
+}
+
+void HexagonalGridAdapter::DrawCell(int x, int y) {
+    float cellSize = grid.GetCellSize();
+    Vector2 center = CellCenter(x, y);
+    
+    Color color;
+    Node* node = grid.GetNode(x, y);
+    if (node) {
+        if (node->occupied) {
+            color = RED;
+        } else if (!node->walkable) {
+            color = DARKGRAY;
+        } else {
+            color = GridRenderer::TerrainColor(grid.GetTerrainCost(x, y));
+        }
+    } else {
+        color = GRAY;
+    }
+    
+    DrawPoly(center, 6, cellSize / 2, 0, color);
+    DrawPolyLines(center, 6, cellSize / 2, 0, LIGHTGRAY);
+}
+
+// Mesmo esquema de GridRenderer::Draw. Os hexágonos se sobrepõem, então uma célula alterada
+// redesenha a vizinhança na ordem do desenho completo, recortada (scissor) à área da célula.
 void HexagonalGridAdapter::Draw() {
     float cellSize = grid.GetCellSize();
     int width = grid.GetWidth();
     int height = grid.GetHeight();
+    int textureWidth = (int)(width * cellSize + cellSize);
+    int textureHeight = (int)((height - 1) * cellSize * 0.866f * 0.75f + cellSize + 1);
+    bool fullRedraw = false;
     
-    float hexWidth = cellSize;
-    float hexHeight = cellSize * 0.866f;
+    // Um snapshot restaurado pode trocar as dimensões do grid.
+    if (renderCache.id != 0 &&
+        (renderCache.texture.width != textureWidth || renderCache.texture.height != textureHeight)) {
+        UnloadRenderTexture(renderCache);
+        renderCache = {0};
+    }
+    if (renderCache.id == 0) {
+        renderCache = LoadRenderTexture(textureWidth, textureHeight);
+        fullRedraw = true;
+    }
     
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            float posX, posY;
-            
-            if (y % 2 == 0) {
-                posX = x * hexWidth;
-                posY = y * hexHeight * 0.75f;
-            } else {
-                posX = x * hexWidth + hexWidth / 2;
-                posY = y * hexHeight * 0.75f;
+    renderDirty.clear();
+    if (!grid.CollectDirtyCells(renderCursor, renderDirty)) {
+        fullRedraw = true;
+    }
+    
+    if (fullRedraw || !renderDirty.empty()) {
+        BeginTextureMode(renderCache);
+        if (fullRedraw) {
+            ClearBackground(BLANK);
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    DrawCell(x, y);
+                }
             }
-            
-            posX += cellSize / 2;
-            posY += cellSize / 2;
-            
-            Color color;
-            Node* node = grid.GetNode(x, y);
-            if (node) {
-                if (node->occupied) {
-                    color = RED;
-                } else if (!node->walkable) {
-                    color = DARKGRAY;
-                } else {
-                    color = GREEN;
+        } else {
+            int radius = (int)std::ceil(cellSize / 2) + 1;
+            for (int cell : renderDirty) {
+                int cx = cell % width;
+                int cy = cell / width;
+                Vector2 center = CellCenter(cx, cy);
+                
+                BeginScissorMode((int)center.x - radius, (int)center.y - radius, 2 * radius, 2 * radius);
+                for (int y = std::max(0, cy - 2); y <= std::min(height - 1, cy + 2); y++) {
+                    for (int x = std::max(0, cx - 1); x <= std::min(width - 1, cx + 1); x++) {
+                        DrawCell(x, y);
+                    }
                 }
-            } else {
-                color = GRAY;
+                EndScissorMode();
             }
-            
-            DrawPoly((Vector2){posX, posY}, 6, cellSize / 2, 0, color);
-            DrawPolyLines((Vector2){posX, posY}, 6, cellSize / 2, 0, LIGHTGRAY);
-            
         }
+        EndTextureMode();
     }
+    
+    DrawTextureRec(renderCache.texture, {0, 0, (float)textureWidth, -(float)textureHeight}, {0, 0}, WHITE);
 }
 
 std::vector<Node*> HexagonalGridAdapter::GetNeighbors(int x, int y) {
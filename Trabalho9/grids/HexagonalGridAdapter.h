@@ -8,11 +8,20 @@ class HexagonalGridAdapter : public IGridAdapter {
 private:
     Grid& grid;
     
+    RenderTexture2D renderCache = {0};
+    uint64_t renderCursor = 0;
+    std::vector<int> renderDirty;
+    
+    Vector2 CellCenter(int x, int y) const;
+    void DrawCell(int x, int y);
+    
 public:
     HexagonalGridAdapter(Grid& grid) : grid(grid) {}
+    ~HexagonalGridAdapter() override;
     
     void Draw() override;
     void SetOccupied(int x, int y, bool occupied) override { grid.SetOccupied(x, y, occupied); }
+    void SetTerrainCost(int x, int y, uint8_t cost) override { grid.SetTerrainCost(x, y, cost); }
     bool IsWalkable(int x, int y) const override { return grid.IsWalkable(x, y); }
     Node* GetNode(int x, int y) override { return grid.GetNode(x, y); }
     
@@ -22,4 +31,4 @@ public:
     int GetWidth() const override { return grid.GetWidth(); }
     int GetHeight() const override { return grid.GetHeight(); }
     float GetCellSize() const override { return grid.GetCellSize(); }
-};
\ No newline at end of file
+};
@@ -2,6 +2,7 @@
 #include "raylib.h"
 #include "Node.h"
 #include <vector>
+#include <cstdint>
 
 class IGridAdapter {
 public:
@@ -9,6 +10,7 @@ public:
     
     virtual void Draw() = 0;
     virtual void SetOccupied(int x, int y, bool occupied) = 0;
+    virtual void SetTerrainCost(int x, int y, uint8_t cost) = 0;
     virtual bool IsWalkable(int x, int y) const = 0;
     virtual Node* GetNode(int x, int y) = 0;
     virtual std::vector<Node*> GetNeighbors(int x, int y) = 0;
@@ -1,16 +1,19 @@
 #pragma once
 #include "IGridAdapter.h"
 #include "Grid.h"
+#include "GridRenderer.h"
 
 class RectangularGridAdapter : public IGridAdapter {
 private:
     Grid& grid;
+    GridRenderer renderer;
     
 public:
-    RectangularGridAdapter(Grid& grid) : grid(grid) {}
+    RectangularGridAdapter(Grid& grid) : grid(grid), renderer(grid) {}
     
-    void Draw() override { grid.Draw(); }
+    void Draw() override { renderer.Draw(); }
     void SetOccupied(int x, int y, bool occupied) override { grid.SetOccupied(x, y, occupied); }
+    void SetTerrainCost(int x, int y, uint8_t cost) override { grid.SetTerrainCost(x, y, cost); }
     bool IsWalkable(int x, int y) const override { return grid.IsWalkable(x, y); }
     Node* GetNode(int x, int y) override { return grid.GetNode(x, y); }
     
@@ -0,0 +1,16 @@
+#include "HeadlessRunner.h"
+#include <cstdio>
+
+// Executável da simulação sem janela, para servidores sem X11/GL. Mesmas opções do
+// modo --ticks do GridNavigation.
+int main(int argc, char** argv) {
+    HeadlessOptions options;
+    if (!ParseHeadlessOptions(argc, argv, options)) {
+        fprintf(stderr, "Uso: %s --ticks N [--agents N] [--width W] [--height H] "
+                        "[--map none|noise|maze|rooms|city] [--seed S] [--threads T] [--steering 0|1]\n"
+                        "       [--checkpoint ARQUIVO [--checkpoint-every N]] [--restore ARQUIVO] [--command-log BASE]\n"
+                        "       [--metrics ARQUIVO]\n", argv[0]);
+        return 1;
+    }
+    return RunHeadless(options);
+}
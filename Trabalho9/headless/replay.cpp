@@ -0,0 +1,126 @@
+#include "CommandLog.h"
+#include "CommandExecutor.h"
+#include "AgentManager.h"
+#include "Grid.h"
+#include "Simulation.h"
+#include "SimulationSnapshot.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+// Lê um log de comandos (GridNavigationHeadless --command-log) e resume o conteúdo. Com
+// --snapshot, reaplica os comandos sobre o snapshot de onde o log começou; com --verify,
+// compara posição e vida de cada agente com um snapshot do fim da execução.
+//
+// Só execuções em que o estado muda apenas por comandos podem ser reaplicadas. Se o log
+// tiver um registro de edição (desfazer, grid editado, agente criado ou removido, snapshot
+// restaurado; ver CommandLog), o replay para nele com erro.
+//
+//   GridNavigationHeadless --ticks 1 --checkpoint inicio.snap
+//   GridNavigationHeadless --restore inicio.snap --ticks 600 --command-log run.wal --checkpoint fim.snap
+//   GridNavigationReplay --log run.wal --snapshot inicio.snap --verify fim.snap
+
+namespace {
+
+struct Scenario {
+    Grid grid{1, 1, 20.0f};
+    AgentManager agentManager{&grid};
+    Simulation simulation{agentManager};
+
+    bool Load(const std::string& path) {
+        std::vector<uint8_t> data;
+        if (!ReadSnapshotFile(path, data) || !RestoreSnapshot(data, grid, simulation, agentManager)) {
+            fprintf(stderr, "Snapshot inválido: %s\n", path.c_str());
+            return false;
+        }
+        return true;
+    }
+};
+
+}
+
+int main(int argc, char** argv) {
+    std::string logPath, snapshotPath, verifyPath;
+    for (int i = 1; i < argc; i += 2) {
+        if (i + 1 == argc) {
+            fprintf(stderr, "Falta o valor de %s\n", argv[i]);
+            return 1;
+        }
+        if (strcmp(argv[i], "--log") == 0) {
+            logPath = argv[i + 1];
+        } else if (strcmp(argv[i], "--snapshot") == 0) {
+            snapshotPath = argv[i + 1];
+        } else if (strcmp(argv[i], "--verify") == 0) {
+            verifyPath = argv[i + 1];
+        } else {
+            fprintf(stderr, "Opção desconhecida: %s\n", argv[i]);
+        }
+    }
+    if (logPath.empty() || (!verifyPath.empty() && snapshotPath.empty())) {
+        fprintf(stderr, "Uso: %s --log BASE [--snapshot INICIO [--verify FIM]]\n", argv[0]);
+        return 1;
+    }
+
+    Scenario scenario;
+    bool replaying = !snapshotPath.empty();
+    if (replaying && !scenario.Load(snapshotPath)) return 1;
+    CommandExecutor executor(scenario.agentManager.GetStorage(), scenario.grid);
+
+    CommandLogReader reader(logPath);
+    uint64_t counts[(int)CommandType::Count] = {};
+    uint64_t records = 0;
+    uint32_t firstTick = 0, lastTick = 0;
+    uint32_t tick;
+    Command command;
+    while (reader.Next(tick, command)) {
+        if (replaying && reader.GetEditCount() > 0) break;
+        if (records == 0) firstTick = tick;
+        lastTick = tick;
+        records++;
+        counts[(int)command.type]++;
+        if (replaying) executor.Replay(command);
+    }
+    if (reader.Failed()) {
+        fprintf(stderr, "Log corrompido em %s (arquivo %u)\n", logPath.c_str(), reader.GetFileCount());
+        return 1;
+    }
+
+    printf("%llu registros em %u arquivo(s)%s | passos %u a %u\n", (unsigned long long)records,
+           reader.GetFileCount(), reader.Truncated() ? " (último registro incompleto)" : "", firstTick, lastTick);
+    printf("MoveAgent: %llu | DamageAgent: %llu | RespawnAgent: %llu | edições: %llu\n",
+           (unsigned long long)counts[(int)CommandType::MoveAgent],
+           (unsigned long long)counts[(int)CommandType::DamageAgent],
+           (unsigned long long)counts[(int)CommandType::RespawnAgent],
+           (unsigned long long)reader.GetEditCount());
+    if (replaying && reader.GetEditCount() > 0) {
+        fprintf(stderr, "O estado mudou por fora dos comandos no passo %u (desfazer, grid, agentes criados ou "
+                        "removidos); o log não reproduz a execução a partir dali\n", reader.GetFirstEditTick());
+        return 3;
+    }
+
+    if (verifyPath.empty()) return 0;
+
+    Scenario expected;
+    if (!expected.Load(verifyPath)) return 1;
+    const AgentStorage& replayed = scenario.agentManager.GetStorage();
+    const AgentStorage& reference = expected.agentManager.GetStorage();
+    int mismatches = 0;
+    double maxError = 0.0;
+    for (int i = 0; i < reference.Size(); i++) {
+        int index = replayed.DenseIndex(reference.handle[i]);
+        if (index < 0) {
+            mismatches++;
+            continue;
+        }
+        double error = std::hypot(replayed.positionX[index] - reference.positionX[i],
+                                  replayed.positionY[index] - reference.positionY[i]);
+        maxError = std::max(maxError, error);
+        if (error != 0.0 || replayed.life[index] != reference.life[i]) mismatches++;
+    }
+    if (replayed.Size() != reference.Size()) mismatches++;
+    printf("Verificação: %d agentes | %d divergentes | maior erro de posição %.6f\n", reference.Size(), mismatches,
+           maxError);
+    return mismatches == 0 ? 0 : 2;
+}
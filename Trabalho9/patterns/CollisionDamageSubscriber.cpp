@@ -0,0 +1,14 @@
+#include "CollisionDamageSubscriber.h"
+#include "AgentManager.h"
+
+CollisionDamageSubscriber::CollisionDamageSubscriber(AgentManager& am, float damagePerContact)
+    : agentManager(am), damagePerContact(damagePerContact) {}
+
+void CollisionDamageSubscriber::OnCollisionEvents(const CollisionEvent* events, int count) {
+    double now = agentManager.GetSimulationTime();
+    for (int i = 0; i < count; i++) {
+        if (events[i].kind != CollisionKind::Contact) continue;
+        agentManager.AddCommand(Command::Damage(events[i].agentA, damagePerContact, now));
+        agentManager.AddCommand(Command::Damage(events[i].agentB, damagePerContact, now));
+    }
+}
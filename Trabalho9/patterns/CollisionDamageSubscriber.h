@@ -0,0 +1,16 @@
+#pragma once
+#include "ICollisionSubscriber.h"
+
+class AgentManager;
+
+// Agenda dano (comando DamageAgent) para os dois agentes de cada contato do quadro.
+class CollisionDamageSubscriber : public ICollisionSubscriber {
+private:
+    AgentManager& agentManager;
+    float damagePerContact;
+
+public:
+    CollisionDamageSubscriber(AgentManager& am, float damagePerContact = 1.0f);
+
+    void OnCollisionEvents(const CollisionEvent* events, int count) override;
+};
@@ -0,0 +1,22 @@
+#pragma once
+#include "AgentHandle.h"
+#include <cstdint>
+#include <type_traits>
+
+enum class CollisionKind : uint8_t {
+    Broad,      // raios amplos se sobrepõem
+    Contact     // raios de colisão se sobrepõem
+};
+
+// Evento de colisão compacto (24 bytes, POD). agentA tem o menor índice de slot;
+// penetration é quanto a soma dos raios do tipo do evento excede a distância entre os
+// centros.
+struct CollisionEvent {
+    AgentHandle agentA;
+    AgentHandle agentB;
+    float penetration;
+    CollisionKind kind;
+};
+
+static_assert(std::is_trivially_copyable<CollisionEvent>::value, "CollisionEvent precisa ser POD");
+static_assert(sizeof(CollisionEvent) == 24, "CollisionEvent deve ocupar 24 bytes");
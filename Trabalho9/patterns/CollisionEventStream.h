@@ -0,0 +1,63 @@
+#pragma once
+#include "CollisionEvent.h"
+#include "ICollisionSubscriber.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// Buffer de eventos de colisão de um quadro. Produtores publicam sem trava: cada lote
+// reserva suas posições com um único fetch_add e copia os eventos para lá. Eventos além
+// da capacidade são descartados e contados. Dispatch roda depois da fase de colisão
+// (a junção do ThreadPool garante que as escritas já são visíveis), entrega o quadro
+// inteiro a cada assinante e esvazia o buffer para o próximo quadro.
+class CollisionEventStream {
+private:
+    std::vector<CollisionEvent> events;
+    std::atomic<int64_t> writeIndex{0};
+    std::atomic<int64_t> dropped{0};
+    int64_t lastDropped = 0;
+    int lastCount = 0;
+    std::vector<ICollisionSubscriber*> subscribers;
+    
+public:
+    explicit CollisionEventStream(int capacity = 1 << 18) : events(capacity) {}
+    
+    void Publish(const CollisionEvent* batch, int count) {
+        if (count <= 0) return;
+        const int64_t capacity = (int64_t)events.size();
+        const int64_t base = writeIndex.fetch_add(count, std::memory_order_relaxed);
+        const int64_t fits = std::max<int64_t>(0, std::min<int64_t>(count, capacity - base));
+        if (fits > 0) {
+            std::copy(batch, batch + fits, events.begin() + base);
+        }
+        if (fits < count) {
+            dropped.fetch_add(count - fits, std::memory_order_relaxed);
+        }
+    }
+    
+    void Publish(const CollisionEvent& event) { Publish(&event, 1); }
+    
+    void Subscribe(ICollisionSubscriber* subscriber) {
+        if (std::find(subscribers.begin(), subscribers.end(), subscriber) == subscribers.end()) {
+            subscribers.push_back(subscriber);
+        }
+    }
+    
+    void Unsubscribe(ICollisionSubscriber* subscriber) {
+        subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), subscriber), subscribers.end());
+    }
+    
+    void Dispatch() {
+        lastCount = (int)std::min<int64_t>(writeIndex.load(std::memory_order_acquire), (int64_t)events.size());
+        lastDropped = dropped.exchange(0);
+        for (ICollisionSubscriber* subscriber : subscribers) {
+            subscriber->OnCollisionEvents(events.data(), lastCount);
+        }
+        writeIndex.store(0, std::memory_order_relaxed);
+    }
+    
+    int GetLastCount() const { return lastCount; }
+    int64_t GetLastDropped() const { return lastDropped; }
+    int GetCapacity() const { return (int)events.size(); }
+};
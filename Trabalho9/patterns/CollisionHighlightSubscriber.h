@@ -0,0 +1,33 @@
+#pragma once
+#include "ICollisionSubscriber.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Marca os agentes que estão em contato no quadro atual, para a interface destacá-los.
+class CollisionHighlightSubscriber : public ICollisionSubscriber {
+private:
+    // Por slot: geração + 1 do agente em contato neste quadro, ou 0.
+    std::vector<uint32_t> contactGeneration;
+
+    void Mark(AgentHandle agent) {
+        if (contactGeneration.size() <= agent.index) {
+            contactGeneration.resize(agent.index + 1, 0);
+        }
+        contactGeneration[agent.index] = agent.generation + 1;
+    }
+
+public:
+    void OnCollisionEvents(const CollisionEvent* events, int count) override {
+        std::fill(contactGeneration.begin(), contactGeneration.end(), 0);
+        for (int i = 0; i < count; i++) {
+            if (events[i].kind != CollisionKind::Contact) continue;
+            Mark(events[i].agentA);
+            Mark(events[i].agentB);
+        }
+    }
+
+    bool IsInContact(AgentHandle agent) const {
+        return agent.index < contactGeneration.size() && contactGeneration[agent.index] == agent.generation + 1;
+    }
+};
@@ -0,0 +1,43 @@
+#pragma once
+#include "ICollisionSubscriber.h"
+#include <chrono>
+#include <cstdio>
+
+// Registro opcional das colisões no console, limitado a `maxLinesPerSecond` linhas.
+// O que passa do limite é só contado e resumido numa linha quando a janela vira.
+class CollisionLogSubscriber : public ICollisionSubscriber {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    int maxLinesPerSecond;
+    int linesInWindow = 0;
+    long long suppressed = 0;
+    Clock::time_point windowStart = Clock::now();
+
+public:
+    explicit CollisionLogSubscriber(int maxLinesPerSecond = 20) : maxLinesPerSecond(maxLinesPerSecond) {}
+
+    void OnCollisionEvents(const CollisionEvent* events, int count) override {
+        Clock::time_point now = Clock::now();
+        if (now - windowStart >= std::chrono::seconds(1)) {
+            if (suppressed > 0) {
+                printf("(%lld colisões omitidas no último segundo)\n\n", suppressed);
+            }
+            windowStart = now;
+            linesInWindow = 0;
+            suppressed = 0;
+        }
+
+        for (int i = 0; i < count; i++) {
+            if (linesInWindow >= maxLinesPerSecond) {
+                suppressed += count - i;
+                return;
+            }
+            const CollisionEvent& event = events[i];
+            printf("Colisão %s detectada entre %d e %d (penetração %.2f)\n\n",
+                   event.kind == CollisionKind::Contact ? "menor" : "maior",
+                   event.agentA.index, event.agentB.index, event.penetration);
+            linesInWindow++;
+        }
+    }
+};
@@ -0,0 +1,34 @@
+#pragma once
+#include "ICollisionSubscriber.h"
+#include <algorithm>
+#include <cstdint>
+
+// Contadores de colisão do último quadro e acumulados.
+class CollisionMetricsSubscriber : public ICollisionSubscriber {
+private:
+    int broadCount = 0;
+    int contactCount = 0;
+    float maxPenetration = 0.0f;
+    int64_t totalContacts = 0;
+
+public:
+    void OnCollisionEvents(const CollisionEvent* events, int count) override {
+        broadCount = 0;
+        contactCount = 0;
+        maxPenetration = 0.0f;
+        for (int i = 0; i < count; i++) {
+            if (events[i].kind == CollisionKind::Contact) {
+                contactCount++;
+                maxPenetration = std::max(maxPenetration, events[i].penetration);
+            } else {
+                broadCount++;
+            }
+        }
+        totalContacts += contactCount;
+    }
+
+    int GetBroadCount() const { return broadCount; }
+    int GetContactCount() const { return contactCount; }
+    float GetMaxPenetration() const { return maxPenetration; }
+    int64_t GetTotalContacts() const { return totalContacts; }
+};
@@ -1,11 +1,74 @@
 #pragma once
-#include "raylib.h"
+#include "NavTypes.h"
+#include "AgentHandle.h"
+#include <cstdint>
+#include <type_traits>
 
-class Command {
-public:
-    virtual ~Command() = default;
-    virtual void Execute() = 0;
-    virtual void Undo() = 0;
-    
+// Tipos de comando. São gravados em snapshots: tipos novos entram no fim.
+enum class CommandType : uint8_t {
+    MoveAgent,     // move o agente de move.from para move.to
+    DamageAgent,   // tira damage.amount de vida; se zerar, agenda um RespawnAgent
+    RespawnAgent,  // leva o agente morto para uma célula livre sorteada e restaura a vida
+    Count
+};
+
+struct MoveCommandData {
+    Vector2 from;
+    Vector2 to;
+};
+
+struct DamageCommandData {
+    float amount;
+};
+
+// `to` e `previousLife` são preenchidos na execução e usados para desfazer.
+struct RespawnCommandData {
+    Vector2 from;
+    Vector2 to;
+    float previousLife;
+};
+
+// Comando guardado por valor: um registro POD com o tipo, o agente alvo e os dados do tipo
+// numa união. CommandBuffer e CommandProcessor guardam Commands direto em vetores que são
+// reaproveitados de um quadro para o outro, então emitir e executar comandos não aloca
+// memória. Execute e Undo são um switch sobre o tipo, em CommandExecutor.
+struct Command {
+    // Tempo de simulação (segundos) a partir do qual o comando pode executar.
     double executionTime;
+    AgentHandle agent;
+    CommandType type;
+    union {
+        MoveCommandData move;
+        DamageCommandData damage;
+        RespawnCommandData respawn;
+    };
+    
+    static Command Move(AgentHandle agent, Vector2 from, Vector2 to, double executionTime = 0.0) {
+        Command command = Make(CommandType::MoveAgent, agent, executionTime);
+        command.move = {from, to};
+        return command;
+    }
+    
+    static Command Damage(AgentHandle agent, float amount, double executionTime = 0.0) {
+        Command command = Make(CommandType::DamageAgent, agent, executionTime);
+        command.damage = {amount};
+        return command;
+    }
+    
+    static Command Respawn(AgentHandle agent, double executionTime = 0.0) {
+        Command command = Make(CommandType::RespawnAgent, agent, executionTime);
+        command.respawn = {{0.0f, 0.0f}, {0.0f, 0.0f}, 0.0f};
+        return command;
+    }
+    
+private:
+    static Command Make(CommandType type, AgentHandle agent, double executionTime) {
+        Command command;
+        command.type = type;
+        command.agent = agent;
+        command.executionTime = executionTime;
+        return command;
+    }
 };
+
+static_assert(std::is_trivially_copyable<Command>::value, "Command precisa ser copiável byte a byte");
@@ -0,0 +1,21 @@
+#pragma once
+#include "Command.h"
+#include <vector>
+
+// Fila local de comandos. Na atualização paralela cada bloco de agentes escreve no seu
+// próprio buffer; o AgentManager junta os buffers no CommandProcessor em ordem de bloco.
+// Os buffers vivem entre quadros e Clear mantém a capacidade, então depois do primeiro
+// pico emitir comandos não aloca memória.
+class CommandBuffer {
+private:
+    std::vector<Command> commands;
+
+public:
+    void AddCommand(const Command& command) {
+        commands.push_back(command);
+    }
+
+    const std::vector<Command>& GetCommands() const { return commands; }
+    bool IsEmpty() const { return commands.empty(); }
+    void Clear() { commands.clear(); }
+};
@@ -0,0 +1,98 @@
+#include "CommandExecutor.h"
+#include "Agent.h"
+
+namespace {
+
+void PlaceAgent(AgentStorage& agents, int index, Vector2 position) {
+    agents.positionX[index] = position.x;
+    agents.positionY[index] = position.y;
+    agents.previousX[index] = position.x;
+    agents.previousY[index] = position.y;
+    agents.velocityX[index] = 0.0f;
+    agents.velocityY[index] = 0.0f;
+}
+
+}
+
+bool CommandExecutor::Execute(Command& command) {
+    int index = agents.DenseIndex(command.agent);
+    if (index < 0) return false;
+    
+    switch (command.type) {
+        case CommandType::MoveAgent:
+            Agent(agents, index).SetPosition(command.move.to);
+            return true;
+        
+        // Se a vida zerar, o AgentRespawnObserver agenda um RespawnAgent.
+        case CommandType::DamageAgent:
+            Agent(agents, index).TakeDamage(command.damage.amount);
+            return true;
+        
+        case CommandType::RespawnAgent: {
+            int cellX, cellY;
+            if (agents.life[index] > 0 || !grid.RandomFreeCell(cellX, cellY)) return false;
+            float cellSize = grid.GetCellSize();
+            command.respawn.from = {agents.positionX[index], agents.positionY[index]};
+            command.respawn.to = {cellX * cellSize + cellSize / 2, cellY * cellSize + cellSize / 2};
+            command.respawn.previousLife = agents.life[index];
+            PlaceAgent(agents, index, command.respawn.to);
+            agents.life[index] = AgentStorage::MAX_LIFE;
+            agents.RequestPath(index);
+            return true;
+        }
+        
+        case CommandType::Count:
+            break;
+    }
+    return false;
+}
+
+// Desfazer um movimento ou respawn tira o agente do caminho: ele acorda e recalcula a
+// partir da posição restaurada.
+void CommandExecutor::Undo(const Command& command) {
+    int index = agents.DenseIndex(command.agent);
+    if (index < 0) return;
+    
+    switch (command.type) {
+        case CommandType::MoveAgent:
+            Agent(agents, index).SetPosition(command.move.from);
+            agents.RequestPath(index);
+            break;
+        
+        case CommandType::DamageAgent:
+            agents.life[index] += command.damage.amount;
+            break;
+        
+        case CommandType::RespawnAgent:
+            PlaceAgent(agents, index, command.respawn.from);
+            agents.life[index] = command.respawn.previousLife;
+            agents.RequestPath(index);
+            break;
+        
+        case CommandType::Count:
+            break;
+    }
+}
+
+void CommandExecutor::Replay(const Command& command) {
+    int index = agents.DenseIndex(command.agent);
+    if (index < 0) return;
+    
+    switch (command.type) {
+        case CommandType::MoveAgent:
+            Agent(agents, index).SetPosition(command.move.to);
+            break;
+        
+        case CommandType::DamageAgent:
+            agents.life[index] -= command.damage.amount;
+            break;
+        
+        case CommandType::RespawnAgent:
+            PlaceAgent(agents, index, command.respawn.to);
+            agents.life[index] = AgentStorage::MAX_LIFE;
+            break;
+        
+        case CommandType::Count:
+            break;
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include "Command.h"
+#include "AgentStorage.h"
+#include "Grid.h"
+
+// Execução dos comandos: um switch sobre Command::type, sem chamadas virtuais. Comandos
+// guardam o handle do agente; se ele foi removido antes da execução (ou do desfazer), o
+// comando não faz nada.
+class CommandExecutor {
+private:
+    AgentStorage& agents;
+    Grid& grid;
+    
+public:
+    CommandExecutor(AgentStorage& agents, Grid& grid) : agents(agents), grid(grid) {}
+    
+    // Aplica o comando e completa os campos que Undo precisa. Retorna false se o comando
+    // não teve efeito (agente removido, respawn de um agente que já voltou); esses não
+    // entram no histórico.
+    bool Execute(Command& command);
+    
+    // Comandos que só leem e escrevem os campos do próprio agente: comandos desses tipos
+    // com agentes diferentes podem executar em paralelo. Dano acorda o agente (lista de
+    // ativos compartilhada) e avisa observadores; respawn sorteia no Grid.
+    static bool IsAgentLocal(CommandType type) { return type == CommandType::MoveAgent; }
+    void Undo(const Command& command);
+    // Reaplica um comando lido do CommandLog: movimento e respawn vão direto para `to`,
+    // dano só desconta a vida. Não sorteia nem avisa observadores (o respawn que o dano
+    // provocou está no log).
+    void Replay(const Command& command);
+    
+    const AgentStorage& GetAgents() const { return agents; }
+};
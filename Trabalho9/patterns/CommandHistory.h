@@ -0,0 +1,174 @@
+#pragma once
+#include "Command.h"
+#include "AgentStorage.h"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Histórico de desfazer em anel de tamanho fixo (depth registros): quando enche, o
+// registro mais antigo é descartado, então a memória não cresce com o tempo de execução.
+//
+// Cada registro tem 24 bytes. Um movimento guarda só o deslocamento (to - from) quantizado
+// em 1/DELTA_SCALE de pixel em dois int16; ao desfazer, a posição anterior é a atual menos
+// o deslocamento (desfazendo em ordem inversa, a posição atual é a do fim do movimento).
+// Deslocamentos que não cabem no int16 guardam a posição anterior inteira. Cada
+// quantização erra no máximo meio passo (1/512 de pixel), somado por movimento juntado.
+//
+// Movimentos seguidos do mesmo agente (sem dano ou respawn dele no meio) se juntam no
+// registro do primeiro, que passa a cobrir do início ao fim da sequência, desde que o
+// último movimento seja no máximo MAX_MERGE_TICKS passos depois do primeiro. Assim cada U
+// volta o agente no máximo esse tanto, o erro acumulado fica limitado a MAX_MERGE_TICKS
+// quantizações, e a ordem do desfazer só difere da cronológica entre agentes diferentes
+// (o que não muda o resultado) dentro dessa janela.
+class CommandHistory {
+public:
+    static constexpr int DEFAULT_DEPTH = 1 << 16;
+    static constexpr float DELTA_SCALE = 256.0f;
+    // Passos (um quarto de segundo a 60 Hz) que um registro de movimento pode cobrir.
+    static constexpr uint16_t MAX_MERGE_TICKS = 15;
+
+private:
+    static constexpr uint64_t NO_RECORD = UINT64_MAX;
+
+    struct RespawnUndo {
+        Vector2 from;
+        float previousLife;
+    };
+
+    struct Record {
+        AgentHandle agent;
+        CommandType type;
+        // Movimento com a posição anterior inteira em `from` em vez de `delta`.
+        bool wide;
+        // 16 bits baixos do passo do primeiro movimento do registro.
+        uint16_t firstTick;
+        union {
+            int16_t delta[2];
+            Vector2 from;
+            float amount;
+            RespawnUndo respawn;
+        };
+    };
+    static_assert(sizeof(Record) == 24, "registro do histórico deveria ter 24 bytes");
+
+    // ring[i % depth] guarda o registro de número absoluto i, para i em [first, end).
+    std::vector<Record> ring;
+    uint64_t first = 0;
+    uint64_t end = 0;
+    // Último registro de cada slot de agente, se for um movimento ainda aberto para juntar.
+    std::vector<uint64_t> openMove;
+
+    Record& At(uint64_t number) { return ring[number % ring.size()]; }
+
+    static bool Quantize(float dx, float dy, int16_t* out) {
+        float qx = std::round(dx * DELTA_SCALE);
+        float qy = std::round(dy * DELTA_SCALE);
+        if (std::fabs(qx) > INT16_MAX || std::fabs(qy) > INT16_MAX) return false;
+        out[0] = (int16_t)qx;
+        out[1] = (int16_t)qy;
+        return true;
+    }
+
+    // Posição anterior de um movimento, dada a posição no fim dele.
+    static Vector2 MoveOrigin(const Record& record, Vector2 end) {
+        if (record.wide) return record.from;
+        return {end.x - record.delta[0] / DELTA_SCALE, end.y - record.delta[1] / DELTA_SCALE};
+    }
+
+    static void SetMove(Record& record, Vector2 from, Vector2 to) {
+        record.wide = !Quantize(to.x - from.x, to.y - from.y, record.delta);
+        if (record.wide) record.from = from;
+    }
+
+    uint64_t& OpenMove(uint32_t slot) {
+        if (slot >= openMove.size()) openMove.resize(slot + 1, NO_RECORD);
+        return openMove[slot];
+    }
+
+    void Push(const Record& record) {
+        if (end - first == ring.size()) first++;
+        At(end) = record;
+        end++;
+    }
+
+public:
+    explicit CommandHistory(int depth = DEFAULT_DEPTH) { SetDepth(depth); }
+
+    // Muda a profundidade mantendo os registros mais recentes que couberem.
+    void SetDepth(int depth) {
+        if (depth < 1) depth = 1;
+        std::vector<Record> resized(depth);
+        uint64_t newFirst = end - first > (uint64_t)depth ? end - depth : first;
+        for (uint64_t number = newFirst; number < end; number++) {
+            resized[number % depth] = At(number);
+        }
+        ring.swap(resized);
+        first = newFirst;
+    }
+
+    int GetDepth() const { return (int)ring.size(); }
+    int GetSize() const { return (int)(end - first); }
+
+    void Clear() {
+        first = end;
+        openMove.assign(openMove.size(), NO_RECORD);
+    }
+
+    // Registra um comando já executado (com os campos de desfazer preenchidos) no passo
+    // `tick` da simulação.
+    void Add(const Command& command, uint32_t tick) {
+        uint64_t& open = OpenMove(command.agent.index);
+        if (command.type == CommandType::MoveAgent && open != NO_RECORD && open >= first) {
+            Record& record = At(open);
+            if (record.agent == command.agent && (uint16_t)(tick - record.firstTick) <= MAX_MERGE_TICKS) {
+                SetMove(record, MoveOrigin(record, command.move.from), command.move.to);
+                return;
+            }
+        }
+
+        Record record;
+        record.agent = command.agent;
+        record.type = command.type;
+        record.wide = false;
+        record.firstTick = (uint16_t)tick;
+        switch (command.type) {
+            case CommandType::MoveAgent: SetMove(record, command.move.from, command.move.to); break;
+            case CommandType::DamageAgent: record.amount = command.damage.amount; break;
+            case CommandType::RespawnAgent: record.respawn = {command.respawn.from, command.respawn.previousLife}; break;
+            case CommandType::Count: return;
+        }
+        Push(record);
+        open = command.type == CommandType::MoveAgent ? end - 1 : NO_RECORD;
+    }
+
+    // Tira o registro mais recente e monta o comando que o desfaz com CommandExecutor::Undo.
+    // Movimentos são reconstruídos a partir da posição atual do agente em `agents`.
+    bool PopLast(const AgentStorage& agents, Command& command) {
+        if (end == first) return false;
+        end--;
+        const Record& record = At(end);
+        if (record.agent.index < openMove.size() && openMove[record.agent.index] == end) {
+            openMove[record.agent.index] = NO_RECORD;
+        }
+
+        switch (record.type) {
+            case CommandType::MoveAgent: {
+                int index = agents.DenseIndex(record.agent);
+                Vector2 current = index >= 0 ? Vector2{agents.positionX[index], agents.positionY[index]} : Vector2{0, 0};
+                command = Command::Move(record.agent, MoveOrigin(record, current), current);
+                break;
+            }
+            case CommandType::DamageAgent:
+                command = Command::Damage(record.agent, record.amount);
+                break;
+            case CommandType::RespawnAgent:
+                command = Command::Respawn(record.agent);
+                command.respawn.from = record.respawn.from;
+                command.respawn.previousLife = record.respawn.previousLife;
+                break;
+            case CommandType::Count:
+                return false;
+        }
+        return true;
+    }
+};
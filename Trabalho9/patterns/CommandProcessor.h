@@ -1,35 +1,229 @@
 #pragma once
 #include "Command.h"
+#include "CommandBuffer.h"
+#include "CommandExecutor.h"
+#include "CommandHistory.h"
+#include "CommandLog.h"
+#include "Snapshot.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstdint>
 #include <vector>
-#include <memory>
 
+// Agenda de comandos ordenada por executionTime: um heap binário de mínimo com chave
+// (executionTime, sequência de chegada). ProcessCommands só toca os comandos vencidos,
+// cada um em O(log n); comandos agendados para o futuro ficam parados no heap. A
+// sequência desempata tempos iguais, então comandos com o mesmo tempo executam na ordem
+// em que foram adicionados.
+//
+// Comandos de um passo costumam chegar todos com o mesmo tempo e em sequência crescente;
+// nesse caso cada inserção para na primeira comparação. A fila guarda os comandos por
+// valor num vetor que mantém a capacidade; o histórico de desfazer é um anel limitado
+// (ver CommandHistory).
+//
+// Os comandos vencidos saem em lotes: uma sequência de comandos locais a um agente (ver
+// CommandExecutor::IsAgentLocal) terminada pelo primeiro comando que não é local. Os
+// locais são separados em partições pelo slot do agente, então os comandos de um mesmo
+// agente caem na mesma partição, na ordem da agenda, e as partições executam em paralelo
+// no ThreadPool. O comando que fecha o lote executa sozinho depois deles. O resultado e o
+// histórico são os mesmos da execução em série.
 class CommandProcessor {
+public:
+    // Abaixo disso o lote executa em série: dividir custaria mais que executar.
+    static constexpr int PARALLEL_MIN_COMMANDS = 4096;
+    
 private:
-    std::vector<std::unique_ptr<Command>> commandQueue;
-    std::vector<std::unique_ptr<Command>> commandHistory;
+    struct ScheduledCommand {
+        uint64_t sequence;
+        Command command;
+    };
+
+    // Ordem invertida: std::push_heap/pop_heap mantêm o maior no topo, e queremos o menor.
+    static bool Later(const ScheduledCommand& a, const ScheduledCommand& b) {
+        if (a.command.executionTime != b.command.executionTime) {
+            return a.command.executionTime > b.command.executionTime;
+        }
+        return a.sequence > b.sequence;
+    }
+
+    std::vector<ScheduledCommand> commandQueue;
+    CommandHistory commandHistory;
+    CommandLogWriter* commandLog = nullptr;
+    uint64_t nextSequence = 0;
+    
+    // Lote em execução e as partições dos comandos locais (índices em `batch`, agrupados
+    // por partição). Reaproveitados de um passo para o outro.
+    std::vector<Command> batch;
+    std::vector<uint8_t> executed;
+    std::vector<int> partitionStart;
+    std::vector<int> partitionCursor;
+    std::vector<int> partitionOrder;
+    
+    void Record(const Command& command, const CommandExecutor& executor) {
+        commandHistory.Add(command, executor.GetAgents().tick);
+        if (commandLog) commandLog->Append(executor.GetAgents().tick, command);
+    }
+    
+    void ExecuteLocal(int count, CommandExecutor& executor) {
+        executed.resize(count);
+        ThreadPool& pool = ThreadPool::GetInstance();
+        if (count < PARALLEL_MIN_COMMANDS || pool.GetThreadCount() < 2) {
+            for (int i = 0; i < count; i++) {
+                executed[i] = executor.Execute(batch[i]);
+            }
+            return;
+        }
+        
+        int partitions = pool.GetThreadCount() * 4;
+        partitionStart.assign(partitions + 1, 0);
+        for (int i = 0; i < count; i++) {
+            partitionStart[batch[i].agent.index % partitions + 1]++;
+        }
+        for (int p = 0; p < partitions; p++) {
+            partitionStart[p + 1] += partitionStart[p];
+        }
+        partitionCursor.assign(partitionStart.begin(), partitionStart.end() - 1);
+        partitionOrder.resize(count);
+        for (int i = 0; i < count; i++) {
+            partitionOrder[partitionCursor[batch[i].agent.index % partitions]++] = i;
+        }
+        
+        pool.ParallelFor(partitions, 1, [&](int begin, int end, int) {
+            for (int p = begin; p < end; p++) {
+                for (int k = partitionStart[p]; k < partitionStart[p + 1]; k++) {
+                    int i = partitionOrder[k];
+                    executed[i] = executor.Execute(batch[i]);
+                }
+            }
+        });
+    }
 
 public:
-    void AddCommand(std::unique_ptr<Command> command) {
-        commandQueue.push_back(std::move(command));
+    // Pode ser chamada durante ProcessCommands (por um comando em execução): se o novo
+    // comando já venceu, executa no mesmo ProcessCommands.
+    void AddCommand(const Command& command) {
+        commandQueue.push_back({nextSequence++, command});
+        std::push_heap(commandQueue.begin(), commandQueue.end(), Later);
+    }
+
+    void AddCommands(CommandBuffer& buffer) {
+        for (const Command& command : buffer.GetCommands()) {
+            AddCommand(command);
+        }
+        buffer.Clear();
+    }
+
+    // Executa, em ordem de (executionTime, chegada), todos os comandos com
+    // executionTime <= currentTime.
+    void ProcessCommands(double currentTime, CommandExecutor& executor) {
+        while (!commandQueue.empty() && commandQueue.front().command.executionTime <= currentTime) {
+            batch.clear();
+            bool closed = false;
+            while (!commandQueue.empty() && commandQueue.front().command.executionTime <= currentTime) {
+                std::pop_heap(commandQueue.begin(), commandQueue.end(), Later);
+                batch.push_back(commandQueue.back().command);
+                commandQueue.pop_back();
+                if (!CommandExecutor::IsAgentLocal(batch.back().type)) {
+                    closed = true;
+                    break;
+                }
+            }
+            
+            int localCount = (int)batch.size() - (closed ? 1 : 0);
+            ExecuteLocal(localCount, executor);
+            for (int i = 0; i < localCount; i++) {
+                if (executed[i]) Record(batch[i], executor);
+            }
+            // Pode agendar novos comandos (AddCommand), vistos na próxima volta.
+            if (closed && executor.Execute(batch.back())) {
+                Record(batch.back(), executor);
+            }
+        }
     }
 
-    void ProcessCommands() {
-        double currentTime = GetTime();
-        for (auto it = commandQueue.begin(); it != commandQueue.end(); ) {
-            if (currentTime >= (*it)->executionTime) {
-                (*it)->Execute();
-                commandHistory.push_back(std::move(*it));
-                it = commandQueue.erase(it);
-            } else {
-                ++it;
+    // Comandos executados passam a ir também para `log` (nullptr desliga). O log não é
+    // do processador: quem liga deve desligar antes de destruí-lo.
+    void SetCommandLog(CommandLogWriter* log) { commandLog = log; }
+    // Avisa o log de uma mudança de estado que não passou por Execute (ver CommandLog).
+    void LogEdit(uint32_t tick) {
+        if (commandLog) commandLog->AppendEdit(tick);
+    }
+    
+    int GetPendingCount() const { return (int)commandQueue.size(); }
+    int GetHistorySize() const { return commandHistory.GetSize(); }
+    int GetHistoryDepth() const { return commandHistory.GetDepth(); }
+    void SetHistoryDepth(int depth) { commandHistory.SetDepth(depth); }
+    void ClearHistory() { commandHistory.Clear(); }
+
+    // Grava a fila de comandos pendentes na ordem de execução. O histórico de desfazer
+    // não entra no snapshot: depois de restaurar não dá para desfazer comandos anteriores
+    // a ele.
+    void SaveSnapshot(SnapshotWriter& out) const {
+        std::vector<const ScheduledCommand*> ordered;
+        ordered.reserve(commandQueue.size());
+        for (const auto& scheduled : commandQueue) {
+            ordered.push_back(&scheduled);
+        }
+        std::sort(ordered.begin(), ordered.end(), [](const ScheduledCommand* a, const ScheduledCommand* b) {
+            return Later(*b, *a);
+        });
+
+        out.Write<uint64_t>(ordered.size());
+        for (const ScheduledCommand* scheduled : ordered) {
+            const Command& command = scheduled->command;
+            out.Write(command.type);
+            out.Write(command.agent);
+            out.Write(command.executionTime);
+            switch (command.type) {
+                case CommandType::MoveAgent: out.Write(command.move); break;
+                case CommandType::DamageAgent: out.Write(command.damage); break;
+                case CommandType::RespawnAgent: out.Write(command.respawn); break;
+                case CommandType::Count: break;
             }
         }
     }
 
-    void UndoLastCommand() {
-        if (!commandHistory.empty()) {
-            commandHistory.back()->Undo();
-            commandHistory.pop_back();
+    // Lê a fila gravada por SaveSnapshot, sem mexer na atual.
+    static bool ReadSnapshot(SnapshotReader& in, std::vector<Command>& commands) {
+        uint64_t count;
+        if (!in.Read(count)) return false;
+        commands.clear();
+        for (uint64_t i = 0; i < count; i++) {
+            Command command;
+            if (!in.Read(command.type) || !in.Read(command.agent) || !in.Read(command.executionTime)) return false;
+            bool ok = false;
+            switch (command.type) {
+                case CommandType::MoveAgent: ok = in.Read(command.move); break;
+                case CommandType::DamageAgent: ok = in.Read(command.damage); break;
+                case CommandType::RespawnAgent: ok = in.Read(command.respawn); break;
+                case CommandType::Count: break;
+            }
+            if (!ok) return in.Fail();
+            commands.push_back(command);
+        }
+        return true;
+    }
+
+    // Substitui a fila pelos comandos lidos do snapshot e limpa o histórico.
+    void RestoreSnapshot(const std::vector<Command>& commands) {
+        commandQueue.clear();
+        commandHistory.Clear();
+        for (const Command& command : commands) {
+            AddCommand(command);
+        }
+    }
+
+    // Desfaz o registro mais recente do histórico. Uma sequência de movimentos do mesmo
+    // agente juntada num registro é desfeita de uma vez. Desfazer um respawn devolve o
+    // agente morto e agenda outro respawn, como estava antes de o primeiro executar.
+    void UndoLastCommand(CommandExecutor& executor) {
+        Command command;
+        if (commandHistory.PopLast(executor.GetAgents(), command)) {
+            executor.Undo(command);
+            LogEdit(executor.GetAgents().tick);
+            if (command.type == CommandType::RespawnAgent) {
+                AddCommand(Command::Respawn(command.agent));
+            }
         }
     }
 };
@@ -0,0 +1,10 @@
+#pragma once
+#include "CollisionEvent.h"
+
+class ICollisionSubscriber {
+public:
+    virtual ~ICollisionSubscriber() = default;
+    // Chamado uma vez por quadro, depois da fase de colisão, com todos os eventos do
+    // quadro (count pode ser 0). O ponteiro só é válido durante a chamada.
+    virtual void OnCollisionEvents(const CollisionEvent* events, int count) = 0;
+};
@@ -0,0 +1,59 @@
+#include "AgentManager.h"
+#include "Grid.h"
+#include "Random.h"
+#include <cstdio>
+#include <vector>
+
+// Remove e recria agentes em rodadas, com passos da simulação no meio. Falha se um handle
+// removido continuar válido, se um handle vivo não achar o próprio agente, ou se o
+// armazenamento crescer: as vagas e a capacidade liberadas devem ser reaproveitadas.
+// Termina desfazendo comandos do histórico, que apontam para agentes já removidos.
+
+int main() {
+    const int agentCount = 2000;
+    const int rounds = 50;
+    const int churnPerRound = 500;
+    const float delta = 1.0f / 60.0f;
+
+    Random::Seed(5);
+    Grid grid(50, 50, 20.0f);
+    AgentManager agentManager(&grid);
+    agentManager.AddRandomAgents(agentCount);
+    const AgentStorage& agents = agentManager.GetStorage();
+    const size_t capacity = agents.positionX.capacity();
+    const size_t slots = agents.slotDense.size();
+
+    std::vector<AgentHandle> removed;
+    int errors = 0;
+    for (int round = 0; round < rounds; round++) {
+        for (int k = 0; k < churnPerRound; k++) {
+            AgentHandle handle = agentManager.GetAgent(Random::Range(0, agentManager.GetAgentCount() - 1)).GetHandle();
+            if (!agentManager.RemoveAgent(handle)) errors++;
+            removed.push_back(handle);
+        }
+        agentManager.UpdateAll(delta);
+        agentManager.CheckCollision();
+
+        agentManager.AddRandomAgents(churnPerRound);
+        for (int i = 0; i < agentManager.GetAgentCount(); i++) {
+            AgentHandle handle = agentManager.GetAgent(i).GetHandle();
+            if (!agentManager.IsValid(handle) || agentManager.GetAgent(handle).GetIndex() != i) errors++;
+        }
+        agentManager.UpdateAll(delta);
+        agentManager.CheckCollision();
+    }
+
+    int staleValid = 0;
+    for (AgentHandle handle : removed) {
+        if (agentManager.IsValid(handle)) staleValid++;
+    }
+    for (int i = 0; i < 200; i++) {
+        agentManager.UndoLastCommand();
+    }
+
+    bool grew = agents.positionX.capacity() != capacity || agents.slotDense.size() != slots;
+    printf("%d agentes | erros %d | handles removidos ainda válidos %d | capacidade %zu -> %zu | vagas %zu -> %zu\n",
+           agentManager.GetAgentCount(), errors, staleValid, capacity, agents.positionX.capacity(), slots,
+           agents.slotDense.size());
+    return errors == 0 && staleValid == 0 && !grew && agentManager.GetAgentCount() == agentCount ? 0 : 1;
+}
@@ -0,0 +1,77 @@
+#include "AgentManager.h"
+#include "Grid.h"
+#include "Random.h"
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <utility>
+#include <vector>
+
+// Compara os pares que CheckCollision publica com uma verificação O(n²) de todos os pares.
+// Os agentes ficam espalhados inclusive fora do grid e um em cada sete tem raio amplo
+// maior que a célula do hash, para passar pelos casos de borda da broadphase. Falha se
+// faltar ou sobrar algum par, ou se um par sair repetido.
+
+namespace {
+
+struct EventCollector : ICollisionSubscriber {
+    std::vector<CollisionEvent> events;
+    void OnCollisionEvents(const CollisionEvent* batch, int count) override {
+        events.insert(events.end(), batch, batch + count);
+    }
+};
+
+using PairSet = std::set<std::pair<uint32_t, uint32_t>>;
+
+std::pair<uint32_t, uint32_t> Ordered(uint32_t a, uint32_t b) { return a < b ? std::make_pair(a, b) : std::make_pair(b, a); }
+
+}
+
+int main(int argc, char** argv) {
+    const int agentCount = argc > 1 ? atoi(argv[1]) : 3000;
+    const int gridSize = argc > 2 ? atoi(argv[2]) : 60;
+    const float cellSize = 20.0f;
+
+    Random::Seed(3);
+    Grid grid(gridSize, gridSize, cellSize);
+    AgentManager agentManager(&grid);
+    agentManager.AddRandomAgents(agentCount);
+    AgentStorage& agents = agentManager.GetStorage();
+    const int span = (int)(gridSize * cellSize);
+    for (int i = 0; i < agents.Size(); i++) {
+        agents.positionX[i] = Random::Range(-100, span + 100) + Random::Range(0, 99) / 100.0f;
+        agents.positionY[i] = Random::Range(-100, span + 100) + 0.5f;
+        if (i % 7 == 0) agents.broadRadius[i] = 25.0f;
+    }
+
+    EventCollector collector;
+    agentManager.GetCollisionEvents().Subscribe(&collector);
+    agentManager.CheckCollision();
+
+    PairSet broad, collision;
+    int duplicates = 0;
+    for (const CollisionEvent& event : collector.events) {
+        PairSet& pairs = event.kind == CollisionKind::Broad ? broad : collision;
+        if (!pairs.insert(Ordered(event.agentA.index, event.agentB.index)).second) duplicates++;
+    }
+
+    PairSet expectedBroad, expectedCollision;
+    for (int i = 0; i < agents.Size(); i++) {
+        for (int j = i + 1; j < agents.Size(); j++) {
+            float dx = agents.positionX[i] - agents.positionX[j];
+            float dy = agents.positionY[i] - agents.positionY[j];
+            float distanceSq = dx * dx + dy * dy;
+            float broadSum = agents.broadRadius[i] + agents.broadRadius[j];
+            float collisionSum = agents.collRadius[i] + agents.collRadius[j];
+            if (distanceSq > broadSum * broadSum) continue;
+            auto pair = Ordered(agents.handle[i].index, agents.handle[j].index);
+            expectedBroad.insert(pair);
+            if (distanceSq <= collisionSum * collisionSum) expectedCollision.insert(pair);
+        }
+    }
+
+    bool ok = broad == expectedBroad && collision == expectedCollision && duplicates == 0;
+    printf("%d agentes | amplos %zu (esperados %zu) | colisões %zu (esperadas %zu) | repetidos %d\n",
+           agents.Size(), broad.size(), expectedBroad.size(), collision.size(), expectedCollision.size(), duplicates);
+    return ok ? 0 : 1;
+}